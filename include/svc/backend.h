@@ -0,0 +1,262 @@
+/*
+* Copyright FSys Tech Limited [FSys]. All rights reserved.
+*
+* This software owned by FSys Tech Limited [FSys] and is protected by copyright law
+* and international copyright treaties.
+*
+* Access to and use of the software is governed by the terms of the applicable FSys Software
+* Services Agreement (the Agreement) and Customer end user license agreements granting
+* a non-assignable, non-transferable and non-exclusive license to use the software
+* for it's own data processing purposes under the terms defined in the Agreement.
+*
+* Except as otherwise granted within the terms of the Agreement, copying or reproduction of any part
+* of this source code or associated reference material to any other location for further reproduction
+* or redistribution, and any amendments to this copyright notice, are expressly prohibited.
+*
+* Any reproduction or redistribution for sale or hiring of the Software not in accordance with
+* the terms of the Agreement is a violation of copyright law.
+*/
+// 10:12 AM 10/16/2026
+// by Rajib Chy
+#ifdef _MSC_VER
+#pragma once
+#endif//_MSC_VER
+
+#ifndef _fsys_svc_backend_h
+#define _fsys_svc_backend_h
+#include <cstdint>
+#include <string>
+#include <memory>
+#include <vector>
+#include <functional>
+#include <svc/job.h>
+
+/**
+ * @brief The `ActiveState` of a systemd unit.
+ */
+enum class unit_active_state : uint8_t {
+    INACTIVE = 0, ///< "inactive", also reported for empty or unavailable states.
+    ACTIVE, ///< "active"
+    RELOADING, ///< "reloading"
+    FAILED, ///< "failed"
+    ACTIVATING, ///< "activating"
+    DEACTIVATING, ///< "deactivating"
+    MAINTENANCE, ///< "maintenance"
+    REFRESHING, ///< "refreshing"
+    UNKNOWN ///< A state this build does not know.
+};
+
+/**
+ * @brief The `SubState` of a systemd service unit.
+ */
+enum class unit_sub_state : uint8_t {
+    UNKNOWN = 0, ///< Empty, or a state this build does not know.
+    DEAD, ///< "dead"
+    CONDITION, ///< "condition"
+    START_PRE, ///< "start-pre"
+    START, ///< "start"
+    START_POST, ///< "start-post"
+    RUNNING, ///< "running"
+    EXITED, ///< "exited"
+    RELOAD, ///< "reload"
+    STOP, ///< "stop"
+    STOP_WATCHDOG, ///< "stop-watchdog"
+    STOP_SIGTERM, ///< "stop-sigterm"
+    STOP_SIGKILL, ///< "stop-sigkill"
+    STOP_POST, ///< "stop-post"
+    FINAL_WATCHDOG, ///< "final-watchdog"
+    FINAL_SIGTERM, ///< "final-sigterm"
+    FINAL_SIGKILL, ///< "final-sigkill"
+    FAILED, ///< "failed"
+    AUTO_RESTART, ///< "auto-restart"
+    CLEANING ///< "cleaning"
+};
+
+/**
+ * @brief Typed status of a systemd service unit.
+ *
+ * Filled from a single `GetAll` round-trip, or kept up to date from `PropertiesChanged`
+ * for watched units. Fields a source does not provide stay at their defaults.
+ */
+struct unit_status {
+    unit_active_state active_state = unit_active_state::INACTIVE; ///< `ActiveState`.
+    unit_sub_state sub_state = unit_sub_state::UNKNOWN; ///< `SubState`.
+    uint32_t main_pid = 0; ///< `MainPID`, 0 when the service has no main process.
+    uint32_t restarts = 0; ///< `NRestarts`, automatic restarts since the unit was last started manually.
+    uint64_t active_enter_timestamp = 0; ///< `ActiveEnterTimestamp`, microseconds since the epoch, 0 if never.
+    uint64_t inactive_exit_timestamp = 0; ///< `InactiveExitTimestamp`, microseconds since the epoch, 0 if never.
+    int32_t exec_main_status = 0; ///< `ExecMainStatus`, exit code or signal of the last main process.
+};
+
+/**
+ * @brief A unit operation that queues a systemd job.
+ */
+enum class unit_operation {
+    START,  ///< `StartUnit`
+    STOP,   ///< `StopUnit`
+    RESTART ///< `RestartUnit`
+};
+
+/**
+ * @brief One operation of a pipelined batch, see `service_manager_t::call_many`.
+ */
+struct unit_request {
+    unit_operation operation = unit_operation::START; ///< The operation to perform.
+    std::string service_name; ///< The name of the service (e.g., "example.service").
+    bool reset_failed = false; ///< Resets the unit's "failed" state first, sent ahead within the batch.
+    int status = 0; ///< Set to 1 if the job was queued, or -1 if the call failed.
+    std::shared_ptr<service_job_t> job; ///< Receives the job handle if queued.
+    std::string error; ///< Receives the error of the failed call.
+};
+
+/**
+ * @brief Descriptor, events and timeout a backend waits for, see `service_backend_t::get_poll_data`.
+ */
+struct backend_poll_data {
+    int fd = -1; ///< Descriptor to poll.
+    short int events = 0; ///< `poll` events to wait for on `fd`.
+    int timeout = -1; ///< Milliseconds until `process_pending` is due anyway, -1 for none.
+    int event_fd = -1; ///< Descriptor readable when other threads queued work, -1 if not used.
+};
+
+/**
+ * @class service_backend_t
+ * @brief Interface of the service manager the handler and workers drive.
+ *
+ * Implemented by `service_manager_t` on systemd's D-Bus API, and by `fake_backend_t`
+ * in memory for benchmarks that need neither root nor systemd (non-production builds
+ * only). Methods return 1 on success and -1 on failure with the reason in
+ * `get_last_error`, unless stated otherwise.
+ */
+class service_backend_t {
+public:
+    /**
+     * @brief Callback invoked when the `ActiveState` of a watched unit changes.
+     *
+     * Called on the thread dispatching the backend's events with the service name and its new `ActiveState`.
+     */
+    using state_listener = std::function<void( const std::string& service_name, unit_active_state active_state )>;
+
+    virtual ~service_backend_t( ) = default;
+
+    /**
+     * @brief Gets the descriptors and timeout to wait for; only meaningful with an external loop.
+     *
+     * Query it again before every wait.
+     */
+    virtual backend_poll_data get_poll_data( ) const = 0;
+
+    /**
+     * @brief Dispatches every pending event, e.g. state changes of watched units.
+     *
+     * @return The number of events dispatched.
+     */
+    virtual int process_pending( ) = 0;
+
+    /**
+     * @brief Starts a service and returns the queued job.
+     */
+    virtual int start( const std::string& serviceName, std::shared_ptr<service_job_t>& job ) = 0;
+
+    /**
+     * @brief Stops a service and returns the queued job.
+     */
+    virtual int stop( const std::string& serviceName, std::shared_ptr<service_job_t>& job ) = 0;
+
+    /**
+     * @brief Restarts a service and returns the queued job.
+     */
+    virtual int restart( const std::string& serviceName, std::shared_ptr<service_job_t>& job ) = 0;
+
+    /**
+     * @brief Resets the "failed" state of a unit.
+     */
+    virtual int reset_failed( const std::string& serviceName ) = 0;
+
+    /**
+     * @brief Performs several unit operations, pipelined where the backend can.
+     *
+     * @param requests The operations; each one receives its status, job and error.
+     * @return 1 if every job was queued, or -1 if at least one call failed.
+     */
+    virtual int call_many( std::vector<unit_request>& requests ) = 0;
+
+    /**
+     * @brief Retrieves the status of a service.
+     *
+     * @param status Receives the status; reset to its defaults ("inactive") on failure.
+     */
+    virtual int get_status( const std::string& serviceName, unit_status& status ) = 0;
+
+    /**
+     * @brief Retrieves the `ActiveState` and `SubState` of several services at once.
+     *
+     * @param results Receives one status per name, in the same order.
+     */
+    virtual int get_status_many( const std::vector<std::string>& serviceNames, std::vector<unit_status>& results ) = 0;
+
+    /**
+     * @brief Starts tracking the state of a unit, see `get_cached_status`.
+     */
+    virtual int watch( const std::string& serviceName ) = 0;
+
+    /**
+     * @brief Stops tracking the state of a unit.
+     *
+     * @return 1 if the unit was tracked, or 0 if it was not.
+     */
+    virtual int unwatch( const std::string& serviceName ) = 0;
+
+    /**
+     * @brief Reads the last known status of a watched unit without a round-trip.
+     *
+     * @return 1 if the unit is watched, or 0 if it is not (use `get_status` instead).
+     */
+    virtual int get_cached_status( const std::string& serviceName, unit_status& status ) = 0;
+
+    /**
+     * @brief Sets the callback notified about `ActiveState` changes of watched units.
+     */
+    virtual void set_state_listener( state_listener listener ) = 0;
+
+    /**
+     * @brief Gets the last error message, or nullptr.
+     */
+    virtual const char* get_last_error( ) = 0;
+};
+
+/**
+ * @brief Creates a backend connection.
+ *
+ * The argument is `true` if the owner dispatches its events from its own loop
+ * (see `service_backend_t::get_poll_data`), `false` for a background thread.
+ */
+using service_backend_factory = std::function<std::unique_ptr<service_backend_t>( bool external_loop )>;
+
+/**
+ * @brief Parses a systemd `ActiveState` string.
+ *
+ * @param value The state (e.g. "active"); an empty one is read as "inactive".
+ * @return The matching state, or `unit_active_state::UNKNOWN`.
+ */
+unit_active_state _to_unit_active_state( const std::string& value );
+
+/**
+ * @brief Parses a systemd `SubState` string.
+ *
+ * @param value The state (e.g. "running").
+ * @return The matching state, or `unit_sub_state::UNKNOWN`.
+ */
+unit_sub_state _to_unit_sub_state( const std::string& value );
+
+/**
+ * @brief Gets the systemd name of an `ActiveState`, e.g. "active".
+ */
+const char* _unit_active_state_name( unit_active_state state );
+
+/**
+ * @brief Gets the systemd name of a `SubState`, e.g. "running", or "unknown".
+ */
+const char* _unit_sub_state_name( unit_sub_state state );
+
+#endif //!_fsys_svc_backend_h
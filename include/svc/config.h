@@ -39,37 +39,117 @@
 enum class service_state {
     ACTIVE,   ///< Service is currently active and running.
     INACTIVE, ///< Service is not running.
-    ERROR     ///< Service encountered an error state.
+    ERROR,    ///< Service encountered an error state.
+    FAILED_BACKOFF ///< Service failed to stay up repeatedly; start attempts wait for its backoff.
 };
 
-struct svc_config {
+/**
+ * @brief Scheduling fields of a service, read by the monitor loop on every pass.
+ */
+struct svc_schedule {
+    time_range_t time_range; // parsed "08:30:15" - "23:10:15" and restart time
+    service_state state = service_state::INACTIVE;
     bool is_restarted = false;
     bool required_workday = false;
     bool is_restart_support = false;
     bool has_dependent_service = false;
+    int pending_actions = 0; // submitted to the worker pool, not yet drained
+    int cascades = 0; // restart cascades this service is part of
+    int start_failures = 0; // consecutive starts that did not stay up for the backoff window
+    std::time_t last_start_epoch = 0; // last start submitted by the schedule
+    std::time_t retry_epoch = 0; // parked in FAILED_BACKOFF until then, 0 when not parked
+
+    explicit svc_schedule( const time_range_t& range ) : time_range( range ) { }
+};
+
+/**
+ * @brief Identity of a service, only read for actions, logging and dependency cascades.
+ */
+struct svc_config {
     std::string service_name; // fixc_dse.service
-    std::string start_time;// "08:30:15";
-    std::string end_time;// "23:10:15";
-    std::string restart_time;
-    time_range_t* time_range = nullptr; // time_range_t
-    service_state state = service_state::INACTIVE;
     std::vector<std::string> dependent; /**< List of dependent service. */
 };
 
+/**
+ * @class service_table_t
+ * @brief Owns the configured services.
+ * 
+ * Services live in two index aligned, contiguous tables: the small `svc_schedule`
+ * rows scanned by the monitor loop, and the `svc_config` rows holding the strings.
+ * Both are released at once when the table is cleared or destroyed.
+ */
+class service_table_t {
+public:
+    /**
+     * @brief Appends a service.
+     * 
+     * @return The index of the service in both tables.
+     */
+    size_t add( svc_config&& config, svc_schedule&& schedule );
+
+    /**
+     * @brief Reserves room for `count` services.
+     */
+    void reserve( size_t count );
+
+    /**
+     * @brief Removes all services.
+     */
+    void clear( );
+
+    size_t size( ) const;
+
+    bool empty( ) const;
+
+    svc_schedule& get_schedule( size_t index );
+
+    const svc_schedule& get_schedule( size_t index ) const;
+
+    svc_config& get_config( size_t index );
+
+    const svc_config& get_config( size_t index ) const;
+
+private:
+    std::vector<svc_schedule> _schedules; ///< Hot rows, one per service.
+    std::vector<svc_config> _configs; ///< Cold rows, same index as `_schedules`.
+};
+
+/**
+ * @brief Restart backoff of services that fail to stay up, all durations in seconds.
+ */
+struct backoff_config {
+    int threshold = 3; /**< Consecutive failed starts that park a service in FAILED_BACKOFF. */
+    int window = 60; /**< A start needed again within this time counts as a failure. */
+    int initial = 30; /**< First backoff delay, doubled on every further failure. */
+    int max = 1800; /**< Upper bound of the backoff delay. */
+};
+
+/**
+ * @brief Options of the service handler itself.
+ */
+struct handler_config {
+    int max_parallel = 4; /**< Maximum number of services started or stopped at once within a dependency level. */
+    int workers = 4; /**< Number of threads performing start, stop and restart actions. */
+    int metrics_port = 0; /**< Loopback port of the Prometheus metrics listener, 0 when disabled. */
+    backoff_config backoff; /**< Backoff of services that fail to start. */
+};
+
 
 #ifdef USE_HTTP_DAY_STATUS
 
 void _load_config( 
-    std::vector<svc_config*>& svc_configs, 
+    service_table_t& services, 
     std::vector<dust_clean_config*>& dust_configs,
+    handler_config& handler_cfg,
     std::string& http_server, std::string& http_port 
 );
 
 #else
 
 void _load_config( 
-    std::vector<svc_config*>& svc_configs, 
-    std::vector<dust_clean_config*>& dust_configs
+    service_table_t& services, 
+    std::vector<dust_clean_config*>& dust_configs,
+    handler_config& handler_cfg
 );
 
 #endif //!USE_HTTP_DAY_STATUS
@@ -0,0 +1,115 @@
+/*
+* Copyright FSys Tech Limited [FSys]. All rights reserved.
+*
+* This software owned by FSys Tech Limited [FSys] and is protected by copyright law
+* and international copyright treaties.
+*
+* Access to and use of the software is governed by the terms of the applicable FSys Software
+* Services Agreement (the Agreement) and Customer end user license agreements granting
+* a non-assignable, non-transferable and non-exclusive license to use the software
+* for it's own data processing purposes under the terms defined in the Agreement.
+*
+* Except as otherwise granted within the terms of the Agreement, copying or reproduction of any part
+* of this source code or associated reference material to any other location for further reproduction
+* or redistribution, and any amendments to this copyright notice, are expressly prohibited.
+*
+* Any reproduction or redistribution for sale or hiring of the Software not in accordance with
+* the terms of the Agreement is a violation of copyright law.
+*/
+// 9:20 AM 10/17/2026
+// by Rajib Chy
+
+#ifdef _MSC_VER
+#pragma once
+#endif//_MSC_VER
+
+#ifndef _fsys_svc_control_h
+#define _fsys_svc_control_h
+
+#include <string>
+#include <vector>
+#include <functional>
+#include <unordered_map>
+#include <svc/reactor.h>
+
+/**
+ * @class service_control_t
+ * @brief Local control socket of the service manager.
+ *
+ * Serves a Unix domain stream socket on the monitor loop's reactor. Each request is
+ * one line, a command followed by space separated arguments; each response is either
+ * "OK <n>" followed by n lines, or a single "ERR <reason>" line. Connections stay
+ * open for further requests; a client shutting down its side after sending still
+ * receives the responses before the connection is closed.
+ */
+class service_control_t {
+public:
+    /**
+     * @brief Executes a request.
+     *
+     * @param command The first word of the request line.
+     * @param args The remaining words.
+     * @param lines Receives the response lines.
+     * @return 1 on success, or 0 with the reason in `lines[0]`.
+     */
+    using request_handler = std::function<int( const std::string& command, const std::vector<std::string>& args, std::vector<std::string>& lines )>;
+
+    explicit service_control_t( service_reactor_t& reactor );
+
+    /**
+     * @brief Closes all connections and removes the socket file.
+     */
+    ~service_control_t( );
+
+    service_control_t( const service_control_t& ) = delete;
+    service_control_t& operator=( const service_control_t& ) = delete;
+
+    /**
+     * @brief Binds the socket and starts accepting connections.
+     *
+     * A stale socket file left by a previous run is replaced.
+     *
+     * @param path The socket path (e.g., "./svcm/svcm.sock").
+     * @param handler Executes the requests, on the reactor's thread.
+     * @return 1 on success, or -1 on failure.
+     */
+    int open( const std::string& path, request_handler handler );
+
+    /**
+     * @brief Closes all connections and removes the socket file.
+     */
+    void close( );
+
+    /**
+     * @brief Gets the last error message.
+     */
+    const char* get_last_error( );
+
+private:
+    struct connection {
+        std::string input; ///< Received bytes not yet forming a full line.
+        std::string output; ///< Response bytes not yet written.
+        bool closing = false; ///< The client shut down its side; dropped once `output` is written.
+    };
+
+    void accept_connections( );
+
+    void on_readable( int fd );
+
+    void flush( int fd );
+
+    void drop( int fd );
+
+    void execute( const std::string& line, std::string& output );
+
+    void set_last_error( const char* action );
+
+    service_reactor_t& _reactor; ///< Dispatches the socket events.
+    request_handler _handler; ///< Executes the requests.
+    int _listen_fd = -1; ///< The listening socket.
+    std::string _path; ///< The socket path.
+    std::unordered_map<int, connection> _connections; ///< Open client connections.
+    std::string _last_error; ///< Stores the last error message.
+};
+
+#endif //!_fsys_svc_control_h
@@ -0,0 +1,225 @@
+/*
+* Copyright FSys Tech Limited [FSys]. All rights reserved.
+*
+* This software owned by FSys Tech Limited [FSys] and is protected by copyright law
+* and international copyright treaties.
+*
+* Access to and use of the software is governed by the terms of the applicable FSys Software
+* Services Agreement (the Agreement) and Customer end user license agreements granting
+* a non-assignable, non-transferable and non-exclusive license to use the software
+* for it's own data processing purposes under the terms defined in the Agreement.
+*
+* Except as otherwise granted within the terms of the Agreement, copying or reproduction of any part
+* of this source code or associated reference material to any other location for further reproduction
+* or redistribution, and any amendments to this copyright notice, are expressly prohibited.
+*
+* Any reproduction or redistribution for sale or hiring of the Software not in accordance with
+* the terms of the Agreement is a violation of copyright law.
+*/
+// 4:05 PM 10/16/2026
+// by Rajib Chy
+
+#ifdef _MSC_VER
+#pragma once
+#endif//_MSC_VER
+
+#ifndef _fsys_svc_executor_h
+#define _fsys_svc_executor_h
+
+#include <chrono>
+#include <coroutine>
+#include <exception>
+#include <functional>
+#include <utility>
+#include <deque>
+#include <vector>
+
+/**
+ * @class service_task
+ * @brief Coroutine orchestrating a sequence of service actions.
+ *
+ * A task starts suspended. It is either handed to `service_executor_t::spawn`,
+ * or awaited by another task, which then resumes once it finished.
+ */
+class service_task {
+public:
+    struct promise_type;
+    using handle_type = std::coroutine_handle<promise_type>;
+
+    /**
+     * @brief Resumes the awaiting task, if any, when the task finished.
+     */
+    struct final_awaiter {
+        bool await_ready( ) const noexcept { return false; }
+
+        std::coroutine_handle<> await_suspend( handle_type handle ) noexcept {
+            std::coroutine_handle<> continuation = handle.promise( ).continuation;
+            return continuation ? continuation : std::noop_coroutine( );
+        }
+
+        void await_resume( ) const noexcept { }
+    };
+
+    struct promise_type {
+        std::coroutine_handle<> continuation; ///< The awaiting task, none for spawned tasks.
+        std::exception_ptr exception; ///< Escaped exception, rethrown to the awaiting task.
+
+        service_task get_return_object( ) { return service_task( handle_type::from_promise( *this ) ); }
+        std::suspend_always initial_suspend( ) const noexcept { return { }; }
+        final_awaiter final_suspend( ) const noexcept { return { }; }
+        void return_void( ) const noexcept { }
+        void unhandled_exception( ) { exception = std::current_exception( ); }
+    };
+
+    service_task( service_task&& other ) noexcept : _handle( std::exchange( other._handle, nullptr ) ) { }
+
+    service_task& operator=( service_task&& other ) noexcept {
+        if ( this != &other ) {
+            if ( _handle ) _handle.destroy( );
+            _handle = std::exchange( other._handle, nullptr );
+        }
+        return *this;
+    }
+
+    service_task( const service_task& ) = delete;
+    service_task& operator=( const service_task& ) = delete;
+
+    ~service_task( ) {
+        if ( _handle ) _handle.destroy( );
+    }
+
+    /**
+     * @brief Checks whether the task ran to completion.
+     */
+    bool is_done( ) const { return !_handle || _handle.done( ); }
+
+    bool await_ready( ) const noexcept { return is_done( ); }
+
+    std::coroutine_handle<> await_suspend( std::coroutine_handle<> awaiting ) noexcept {
+        // Run the task right away, it resumes the awaiting task from its final suspend
+        _handle.promise( ).continuation = awaiting;
+        return _handle;
+    }
+
+    void await_resume( ) const {
+        if ( _handle && _handle.promise( ).exception ) {
+            std::rethrow_exception( _handle.promise( ).exception );
+        }
+    }
+
+private:
+    friend class service_executor_t;
+
+    explicit service_task( handle_type handle ) : _handle( handle ) { }
+
+    handle_type _handle; ///< The coroutine frame, owned by the task.
+};
+
+/**
+ * @class service_executor_t
+ * @brief Single-threaded executor of service tasks.
+ *
+ * Tasks suspend on `wait_until`, which resumes them once a condition holds or a
+ * deadline passed. The owner calls `run` whenever a condition may have changed
+ * or `next_deadline` is reached; all tasks run on that thread, interleaved at
+ * their suspension points.
+ */
+class service_executor_t {
+public:
+    using clock = std::chrono::steady_clock;
+    using error_handler = std::function<void( std::exception_ptr exception )>;
+
+    /**
+     * @brief Awaitable returned by `wait_until`; `co_await` yields `true` if the
+     *        condition holds, `false` if the deadline passed first.
+     */
+    class wait_awaiter {
+    public:
+        wait_awaiter( service_executor_t& executor, clock::time_point deadline, std::function<bool( )> condition )
+            : _executor( executor ), _deadline( deadline ), _condition( std::move( condition ) ) { }
+
+        bool await_ready( ) {
+            _result = _condition && _condition( );
+            return _result;
+        }
+
+        void await_suspend( std::coroutine_handle<> handle ) {
+            _executor._waiters.push_back( waiter{ _deadline, &_condition, handle, &_result } );
+        }
+
+        bool await_resume( ) const noexcept { return _result; }
+
+    private:
+        service_executor_t& _executor;
+        clock::time_point _deadline;
+        std::function<bool( )> _condition;
+        bool _result = false;
+    };
+
+    ~service_executor_t( );
+
+    /**
+     * @brief Takes ownership of a task and schedules it; it first runs on the next `run`.
+     *
+     * @param task The task.
+     * @param on_error Receives an exception escaping the task; without one it is dropped.
+     */
+    void spawn( service_task task, error_handler on_error = nullptr );
+
+    /**
+     * @brief Suspends the awaiting task until `condition` holds or `deadline` passed.
+     *
+     * @param deadline The latest point of resumption.
+     * @param condition Checked on every `run`; nullptr to wait for the deadline only.
+     */
+    wait_awaiter wait_until( clock::time_point deadline, std::function<bool( )> condition );
+
+    /**
+     * @brief Suspends the awaiting task until `deadline` passed.
+     */
+    wait_awaiter sleep_until( clock::time_point deadline );
+
+    /**
+     * @brief Resumes every task that became runnable, until none is left.
+     *
+     * Spawned tasks start, waiting tasks whose condition holds or deadline passed
+     * resume, and finished tasks are released. An exception escaping a spawned
+     * task is handed to its `on_error` and never leaves `run`, so one failing task
+     * does not stop the others.
+     */
+    void run( );
+
+    /**
+     * @brief Gets the earliest deadline of the waiting tasks, or `clock::time_point::max()`.
+     */
+    clock::time_point next_deadline( ) const;
+
+    /**
+     * @brief Gets the number of spawned tasks that did not finish yet.
+     */
+    size_t size( ) const;
+
+    /**
+     * @brief Destroys all tasks without resuming them.
+     */
+    void clear( );
+
+private:
+    struct waiter {
+        clock::time_point deadline;
+        std::function<bool( )>* condition; ///< Lives in the suspended frame.
+        std::coroutine_handle<> handle;
+        bool* result; ///< Lives in the suspended frame.
+    };
+
+    struct spawned_task {
+        service_task task;
+        error_handler on_error; ///< Receives an escaped exception.
+    };
+
+    std::vector<spawned_task> _tasks; ///< Spawned tasks.
+    std::deque<std::coroutine_handle<>> _ready; ///< Tasks to resume on the next `run`.
+    std::vector<waiter> _waiters; ///< Suspended tasks.
+};
+
+#endif //!_fsys_svc_executor_h
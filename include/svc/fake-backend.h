@@ -0,0 +1,222 @@
+/*
+* Copyright FSys Tech Limited [FSys]. All rights reserved.
+*
+* This software owned by FSys Tech Limited [FSys] and is protected by copyright law
+* and international copyright treaties.
+*
+* Access to and use of the software is governed by the terms of the applicable FSys Software
+* Services Agreement (the Agreement) and Customer end user license agreements granting
+* a non-assignable, non-transferable and non-exclusive license to use the software
+* for it's own data processing purposes under the terms defined in the Agreement.
+*
+* Except as otherwise granted within the terms of the Agreement, copying or reproduction of any part
+* of this source code or associated reference material to any other location for further reproduction
+* or redistribution, and any amendments to this copyright notice, are expressly prohibited.
+*
+* Any reproduction or redistribution for sale or hiring of the Software not in accordance with
+* the terms of the Agreement is a violation of copyright law.
+*/
+// 10:12 AM 10/16/2026
+// by Rajib Chy
+#ifdef _MSC_VER
+#pragma once
+#endif//_MSC_VER
+
+#ifndef _fsys_svc_fake_backend_h
+#define _fsys_svc_fake_backend_h
+#include <map>
+#include <mutex>
+#include <deque>
+#include <atomic>
+#include <chrono>
+#include <random>
+#include <thread>
+#include <unordered_map>
+#include <condition_variable>
+#include <svc/backend.h>
+
+/**
+ * @brief Latency and failure rate of one kind of fake call.
+ */
+struct fake_operation_config {
+    std::chrono::microseconds latency{ 0 }; /**< Round-trip time of one call; a pipelined batch pays it once. */
+    double failure_rate = 0.0; /**< Share of calls failing, 0 to 1. */
+};
+
+/**
+ * @brief Behaviour of a `fake_systemd_t`.
+ */
+struct fake_backend_config {
+    fake_operation_config start; /**< `StartUnit` calls. */
+    fake_operation_config stop; /**< `StopUnit` calls. */
+    fake_operation_config restart; /**< `RestartUnit` calls. */
+    fake_operation_config status; /**< Status reads, `ResetFailedUnit` and the initial read of a watch. */
+    std::chrono::milliseconds job_duration{ 0 }; /**< Time from queuing a job until it finishes. */
+    double job_failure_rate = 0.0; /**< Share of start and restart jobs that fail and leave the unit "failed". */
+    uint32_t seed = 1; /**< Seed of the failure draws, equal seeds give equal runs. */
+};
+
+class fake_backend_t;
+
+/**
+ * @class fake_systemd_t
+ * @brief In-memory stand-in for systemd, shared by the connections of one run.
+ *
+ * Every unit name exists and starts "inactive". Jobs finish on a timer thread after
+ * `job_duration`, then watched units are notified on their connections. Create it with
+ * `std::make_shared`, the connections keep it alive.
+ */
+class fake_systemd_t : public std::enable_shared_from_this<fake_systemd_t> {
+public:
+    /**
+     * @brief Starts the timer thread.
+     */
+    explicit fake_systemd_t( const fake_backend_config& config );
+
+    /**
+     * @brief Stops the timer thread; jobs still running never finish.
+     */
+    ~fake_systemd_t( );
+
+    fake_systemd_t( const fake_systemd_t& ) = delete;
+    fake_systemd_t& operator=( const fake_systemd_t& ) = delete;
+
+    /**
+     * @brief Gets a factory of connections to this instance, for `service_handler_t` and the worker pool.
+     */
+    service_backend_factory factory( );
+
+    /**
+     * @brief Lets the main process of a unit die, as if killed by SIGKILL.
+     *
+     * The unit becomes "failed"; watched units are notified.
+     *
+     * @param service_name The name of the service (e.g., "example.service").
+     */
+    void kill( const std::string& service_name );
+
+    /**
+     * @brief Gets the number of calls made on all connections.
+     */
+    uint64_t calls( ) const;
+
+private:
+    friend class fake_backend_t;
+
+    struct fake_job {
+        std::string service_name;
+        unit_operation operation;
+        std::shared_ptr<service_job_t> job;
+    };
+
+    const fake_operation_config& operation_config( unit_operation operation ) const;
+
+    void simulate_call( const fake_operation_config& config );
+
+    bool draw_failure( double rate );
+
+    int queue_job( unit_operation operation, const std::string& service_name, std::shared_ptr<service_job_t>& job, std::string& error );
+
+    int read_status( const std::string& service_name, unit_status& status, std::string& error );
+
+    int reset_failed( const std::string& service_name, std::string& error );
+
+    void attach( fake_backend_t* connection );
+
+    void detach( fake_backend_t* connection );
+
+    void notify( const std::vector<std::pair<std::string, unit_status>>& changes );
+
+    void run( );
+
+    unit_status& unit( const std::string& service_name );
+
+    fake_backend_config _config; ///< Latencies and failure rates.
+    std::atomic<uint64_t> _calls = 0; ///< Calls made on all connections.
+    mutable std::mutex _mutex; ///< Guards the units, jobs and the random engine.
+    std::condition_variable _cv; ///< Wakes the timer thread for an earlier job or shutdown.
+    bool _stopping = false; ///< Set by the destructor.
+    std::mt19937 _random; ///< Failure draws.
+    uint32_t _next_pid = 1000; ///< Main PID of the next started unit.
+    uint64_t _next_job = 1; ///< Id of the next job.
+    std::unordered_map<std::string, unit_status> _units; ///< Every unit touched so far.
+    std::multimap<std::chrono::steady_clock::time_point, fake_job> _jobs; ///< Running jobs by due time.
+    std::recursive_mutex _connection_mutex; ///< Guards `_connections`, held while notifying them.
+    std::vector<fake_backend_t*> _connections; ///< Connections notified about state changes.
+    std::thread _thread; ///< Finishes the jobs.
+};
+
+/**
+ * @class fake_backend_t
+ * @brief One connection to a `fake_systemd_t`, implementing `service_backend_t` in memory.
+ *
+ * With an external loop, state changes of watched units are queued and dispatched by
+ * `process_pending` once the descriptor of `get_poll_data` is readable, like D-Bus signals.
+ */
+class fake_backend_t : public service_backend_t {
+public:
+    /**
+     * @brief Connects to a fake systemd.
+     *
+     * @param systemd The instance to connect to.
+     * @param external_loop `true` if the owner dispatches the state changes from its own loop.
+     * @throws std::runtime_error If the event descriptor cannot be created.
+     */
+    fake_backend_t( std::shared_ptr<fake_systemd_t> systemd, bool external_loop );
+
+    /**
+     * @brief Disconnects and closes the event descriptor.
+     */
+    ~fake_backend_t( ) override;
+
+    fake_backend_t( const fake_backend_t& ) = delete;
+    fake_backend_t& operator=( const fake_backend_t& ) = delete;
+
+    backend_poll_data get_poll_data( ) const override;
+
+    int process_pending( ) override;
+
+    int start( const std::string& serviceName, std::shared_ptr<service_job_t>& job ) override;
+
+    int stop( const std::string& serviceName, std::shared_ptr<service_job_t>& job ) override;
+
+    int restart( const std::string& serviceName, std::shared_ptr<service_job_t>& job ) override;
+
+    int reset_failed( const std::string& serviceName ) override;
+
+    int call_many( std::vector<unit_request>& requests ) override;
+
+    int get_status( const std::string& serviceName, unit_status& status ) override;
+
+    int get_status_many( const std::vector<std::string>& serviceNames, std::vector<unit_status>& results ) override;
+
+    int watch( const std::string& serviceName ) override;
+
+    int unwatch( const std::string& serviceName ) override;
+
+    int get_cached_status( const std::string& serviceName, unit_status& status ) override;
+
+    void set_state_listener( state_listener listener ) override;
+
+    const char* get_last_error( ) override;
+
+private:
+    friend class fake_systemd_t;
+
+    int call( unit_operation operation, const std::string& service_name, std::shared_ptr<service_job_t>& job );
+
+    void on_unit_changed( const std::string& service_name, const unit_status& status );
+
+    void update_cache( const std::string& service_name, const unit_status& status );
+
+    std::shared_ptr<fake_systemd_t> _systemd; ///< The instance connected to.
+    bool _external_loop; ///< State changes wait for `process_pending`.
+    int _event_fd = -1; ///< Readable while state changes are queued.
+    std::mutex _mutex; ///< Guards the watch cache, the queue and the listener.
+    std::unordered_map<std::string, unit_status> _watched; ///< Last known status of watched units.
+    std::deque<std::pair<std::string, unit_status>> _pending; ///< State changes awaiting `process_pending`.
+    state_listener _listener; ///< Notified when a watched unit changes its `ActiveState`.
+    std::string _last_error; ///< Stores the last error message encountered.
+};
+
+#endif //!_fsys_svc_fake_backend_h
@@ -31,8 +31,8 @@
 #include <memory>
 #include <vector>
 #include <atomic>
-#include <future>
-#include <chrono>  // Required for std::chrono::seconds
+#include <chrono>  // Required for std::chrono::steady_clock
+#include <random>
 #include <svc/config.h>
 
 #ifdef USE_HTTP_DAY_STATUS
@@ -43,6 +43,16 @@
 #include <svc/time-range.h>
 #include <svc/manager.h>
 #include <svc/dust-cleaner.h>
+#include <svc/scheduler.h>
+#include <svc/registry.h>
+#include <svc/reactor.h>
+#include <svc/control.h>
+#include <svc/metrics.h>
+#include <svc/histogram.h>
+#include <svc/snapshot.h>
+#include <svc/pipeline.h>
+#include <svc/worker-pool.h>
+#include <svc/executor.h>
 
 /**
  * @class service_handler_t
@@ -63,6 +73,14 @@ public:
      */
     service_handler_t();
 
+    /**
+     * @brief Constructs a handler driving the services through another backend.
+     *
+     * @param backend_factory Creates the connections of the monitor loop and the workers,
+     *        e.g. of a `fake_backend_t` for benchmarks without systemd.
+     */
+    explicit service_handler_t( service_backend_factory backend_factory );
+
     /**
      * @brief Destroys the service_handler_t object.
      * 
@@ -99,12 +117,22 @@ private:
      * @brief Handles the transition to a new trading day.
      * 
      * This function checks if the current date has changed compared to the last recorded date.
-     * If a new day has started, it updates the last recorded date, renews the logger, loads the
-     * day's status, cleans up old data if necessary, and prepares the time ranges for all services.
+     * If a new day has started, it updates the last recorded date, renews the logger and
+     * prepares the time ranges for all services, so the schedule goes on right away. Loading
+     * the day's status and the dust clean run on `_pipeline`, see `start_day_pipeline`.
+     */
+    void switch_to_new_day( );
+
+    /**
+     * @brief Starts the background stages of the day switch.
      * 
-     * @return 1 if the transition is successful, 0 if it fails to load the day status.
+     * "trade-date" loads the day's status and swaps in `_is_working_day`; until then
+     * services requiring a workday are left as they are. "dust-clean" runs the cleaner.
+     * A failed "trade-date" stops the manager, as a failed day switch always did.
+     * While an earlier run (e.g. a control `clean`) is in progress, the stages are
+     * started by the monitor loop once it was drained.
      */
-    int switch_to_new_day( );
+    void start_day_pipeline( );
     
     /**
      * @brief Updates the current state of all services.
@@ -116,23 +144,213 @@ private:
      * @note This function does not handle services transitioning to other states.
      */
     void update_service_current_state();
+
+    /**
+     * @brief Resumes the runtime state saved by the previous run of the manager.
+     *
+     * Restores today's flags (`is_restarted`) and the backoff of each service from the
+     * snapshot, then validates the states against the watch cache filled by `prepare`,
+     * querying systemd only for services that are not watched.
+     *
+     * @return 1 if a snapshot of today was resumed, or 0 if the state must be queried.
+     */
+    int resume_service_state( );
+
+    /**
+     * @brief Saves the runtime state of all services to the snapshot if it changed.
+     */
+    void persist_service_state( );
     
     /**
      * @brief Waits for a specified duration.
      * 
-     * This function suspends execution for a given number of milliseconds.
+     * This function suspends execution for a given number of milliseconds, measured
+     * on the monotonic clock, while events are still dispatched. Only an exit request
+     * ends the wait early.
      * 
      * @param ms The number of milliseconds to wait.
-     * @return int Returns 1 on success, or an error code if the wait is interrupted.
+     * @return int Returns 1 on success, or 0 if the wait is interrupted by exit.
      */
     int wait_for( long ms );
 
+    /**
+     * @brief Waits until a deadline or until an event source becomes ready.
+     * 
+     * Used by the monitor loop so that a failing service is handled as soon as systemd
+     * reports it, instead of on the next boundary. D-Bus messages, signals and
+     * configuration changes are dispatched before this returns.
+     * 
+     * @param deadline The monotonic point in time to wake up at the latest.
+     * @return int Returns 1 on deadline or event, or 0 if exit was requested.
+     */
+    int wait_for_event( service_reactor_t::clock::time_point deadline );
+
+    /**
+     * @brief Registers the D-Bus connection, the handled signals and the
+     *        configuration directory with the reactor.
+     * 
+     * @return int Returns 1 on success, or 0 if a required source cannot be registered.
+     */
+    int attach_event_sources( );
+
+    /**
+     * @brief Executes a request received on the control socket.
+     * 
+     * Commands:
+     * - `list`: one line per service, "<name> <state> <next boundary epoch> <start|end|restart|retry|-> <pending actions> <cascades>",
+     *   answered from memory without any D-Bus call.
+     * - `stats`: "tick_lag|tick_duration <count> <p50> <p90> <p99> <p99.9> <max>" in microseconds, since the last day switch,
+     *   and "status_queries <queries> <memo hits> <most queries of one service in one pass>" since the start.
+     * - `start|stop|restart <service>`: queues the action; the schedule still applies on the next pass.
+     * - `clean`: runs the dust cleaner on `_pipeline`.
+     * - `reload`: requests a configuration reload.
+     * 
+     * @return int Returns 1 on success, or 0 with the reason in `lines[0]`.
+     */
+    int on_control_request( const std::string& command, const std::vector<std::string>& args, std::vector<std::string>& lines );
+
+    /**
+     * @brief Gets the next schedule boundary of a service after `now_time`.
+     * 
+     * @param epoch Receives the epoch of the boundary, or 0 if none is left today.
+     * @param event Receives "start", "end", "restart" or "-".
+     */
+    void get_next_boundary( size_t index, const std::time_t& now_time, std::time_t& epoch, const char*& event ) const;
+
+    /**
+     * @brief Normalizes the service names and resolves the dependency graph.
+     * 
+     * @throws std::runtime_error If the dependency graph contains a cycle.
+     */
+    void build_registry( service_table_t& services, service_registry_t& registry );
+
+    /**
+     * @brief Checks whether no action, cascade or background stage is in flight.
+     */
+    bool is_idle( ) const;
+
+    /**
+     * @brief Re-reads "./svcm/config.json" and applies the difference to the running services.
+     * 
+     * Services are matched by name. Unchanged services keep everything, changed ones keep
+     * their state and get the new schedule, added ones are watched and queried, removed
+     * ones are left as they are. The dust rules are replaced without cleaning. An invalid
+     * file is logged and the running configuration is kept.
+     * 
+     * Must only run while `is_idle`, as service indexes change.
+     * 
+     * @return int Returns 1 if the configuration was applied, or 0 if it was rejected.
+     */
+    int reload_config( );
+
+    /**
+     * @brief Handles a signal received through the reactor.
+     * 
+     * SIGINT and SIGTERM exit, SIGUSR1 re-reads and logs the state of all services,
+     * SIGHUP requests a configuration reload.
+     * 
+     * @param signal The signal number.
+     */
+    void on_signal( int signal );
+
+    /**
+     * @brief Applies the schedule of one service at the given time.
+     * 
+     * Stops services outside their working day or time range, starts services inside
+     * their time range and performs the daily restart. A restart with dependents is
+     * spawned as a `restart_cascade` and returns right away.
+     * 
+     * @param index The index of the service to evaluate.
+     * @param now_time The current system time.
+     * @param restart_due `true` if the restart boundary of the service fired, even if the
+     *        60 second restart window has already passed.
+     */
+    void process_service( size_t index, const std::time_t& now_time, bool restart_due );
+
+    /**
+     * @brief Schedules today's upcoming start, end and restart boundaries of all services.
+     * 
+     * @param now_time The current system time; boundaries before it are not scheduled.
+     */
+    void rebuild_schedule( const std::time_t& now_time );
+
+    /**
+     * @brief Retrieves the current state of all services with a single bulk query.
+     * 
+     * Falls back to one query per service if the bulk query fails.
+     * 
+     * @param states Receives one state per entry of `_services`, in the same order.
+     */
+    void query_service_states( std::vector<service_state>& states );
+
+    /**
+     * @brief Re-reads the state of all services from systemd.
+     * 
+     * Consistency sweep for the in-memory state table, which is otherwise
+     * maintained by change notifications.
+     */
+    void sync_service_state( );
+
+    /**
+     * @brief Applies the results of finished actions to the service table.
+     * 
+     * Updates the state of each service, logs failures and jobs that did not
+     * finish with "done", counts them per service and action, and releases
+     * the pending action count.
+     */
+    void drain_actions( );
+
+    /**
+     * @brief Checks whether no action of the given services is pending.
+     */
+    bool actions_finished( const std::vector<size_t>& indexes ) const;
+
+    /**
+     * @brief Suspends a task until every action submitted for the given services finished.
+     * 
+     * A worker gives up on a job after 120 seconds, so the wait is bounded.
+     * 
+     * @param indexes The indexes of the services to wait for.
+     * @return Awaitable yielding `true` once the actions finished, `false` if no result arrived in time.
+     */
+    service_executor_t::wait_awaiter wait_for_actions( std::vector<size_t> indexes );
+
+    /**
+     * @brief Hands an action to the worker pool and marks it pending on the service.
+     */
+    void submit_action( size_t index, service_action action );
+
     /**
      * @brief Starts the specified service.
      * 
-     * @param service Reference to the service configuration to be started.
+     * The start runs on the worker pool; see `drain_actions` for its completion.
+     * 
+     * @param index The index of the service to be started.
+     */
+    void start_service( size_t index );
+
+    /**
+     * @brief Starts a service found inactive within its time range, backing off if it keeps failing.
+     * 
+     * A start needed again within `backoff.window` of the previous one counts as a failure.
+     * Once `backoff.threshold` failures follow each other, the service is parked in
+     * `FAILED_BACKOFF` for an exponentially growing, jittered delay; the start after the
+     * delay resets the unit's failed state first.
+     * 
+     * @param index The index of the service.
+     * @param now_time The current system time.
+     */
+    void start_scheduled_service( size_t index, const std::time_t& now_time );
+
+    /**
+     * @brief Parks a service in `FAILED_BACKOFF` and schedules its retry.
+     */
+    void back_off_service( size_t index, const std::time_t& now_time );
+
+    /**
+     * @brief Forgets the failures and backoff of a service.
      */
-    void start_service(svc_config& service);
+    void clear_backoff( size_t index );
 
     /**
      * @brief Restarts the given service.
@@ -140,51 +358,85 @@ private:
      * This function stops and then starts the given service, ensuring that
      * it properly restarts if it supports restart functionality.
      * 
-     * @param service The service configuration object to restart.
+     * @param index The index of the service to restart.
+     */
+    void restart_service( size_t index );
+
+    /**
+     * @brief Starts or stops the services of one dependency level concurrently.
+     * 
+     * Actions are queued for up to `max_parallel` services at once, then awaited before
+     * the next batch is queued, so the level is settled when the task finishes.
+     * 
+     * @param level The indexes of the services of the level.
+     * @param now_time The current system time, used to determine whether a service is within its operational time range.
+     * @param stop A boolean flag indicating whether to stop (`true`) or start (`false`) the services.
      */
-    void restart_service(svc_config& service);
+    service_task toggle_dependency_level(
+        std::vector<size_t> level,
+        std::time_t now_time,
+        bool stop
+    );
 
     /**
      * @brief Toggles the state of dependent services based on the current time and stop flag.
      * 
-     * This function iterates over a list of dependent services and determines whether to start 
-     * or stop them based on their current state, operational time range, and a stop flag. 
+     * The dependents are split into topological levels (see `service_registry_t::get_levels`)
+     * and each level is toggled concurrently; the next level begins only once the whole
+     * current level is settled.
      * 
      * Behavior:
      * - If `stop` is `true`:
      *   - Stops services that are **not already inactive**.
-     *   - Recursively stops **dependent services** before stopping the current service.
-     *   - Waits for dependent services to stop before proceeding.
+     *   - Levels are stopped deepest first, so a service stops only after its dependents.
      * - If `stop` is `false`:
      *   - Starts services that are **inactive** and **within their operational time range**.
-     *   - Recursively starts **dependent services** after the current service is restarted.
-     *   - Waits for dependent services to start before proceeding.
+     *   - Levels are started shallowest first, so a service starts only after the services it depends on.
      * 
      * Exit Condition:
      * - If `_exit_flag` is set (`1`), the iteration is terminated immediately.
-     * - If waiting for a dependent service (`wait_for(10000)`) times out, the function exits early.
      * 
-     * @param root_service The name of the root service whose dependencies are being toggled.
-     * @param dependent A list of dependent service names that need to be checked.
+     * @param root_index The index of the root service whose dependents are being toggled.
      * @param now_time The current system time, used to determine whether a service is within its operational time range.
      * @param stop A boolean flag indicating whether to stop (`true`) or start (`false`) the dependent services.
-     * @return The number of services that were successfully toggled (started or stopped).
      */
-    int toggel_dependent_service(
-        const std::string& root_service,
-        const std::vector<std::string>& dependent, 
-        const std::time_t& now_time, 
+    service_task toggel_dependent_service(
+        size_t root_index,
+        std::time_t now_time, 
         bool stop
     );
 
+    /**
+     * @brief Restarts a service together with its dependents.
+     * 
+     * Stops the dependents, restarts the service and starts the dependents again,
+     * each step awaited before the next. The task suspends while actions run, so
+     * the monitor loop keeps scheduling the other services; the services of the
+     * cascade are left to it until it finished, threw or was destroyed.
+     * 
+     * @param index The index of the service to restart.
+     * @param now_time The current system time.
+     */
+    service_task restart_cascade( size_t index, std::time_t now_time );
+
+    /**
+     * @brief Spawns a `restart_cascade` on the executor.
+     * 
+     * An exception escaping the cascade is logged, so the monitor loop keeps running;
+     * the cascade releases its services itself as it unwinds.
+     * 
+     * @param index The index of the service to restart.
+     * @param now_time The current system time.
+     */
+    void spawn_cascade( size_t index, std::time_t now_time );
 
 
     /**
      * @brief Stops the specified service.
      * 
-     * @param service Reference to the service configuration to be stopped.
+     * @param index The index of the service to be stopped.
      */
-    void stop_service(svc_config& service);
+    void stop_service( size_t index );
 
     /**
      * @brief Retrieves the current status of a given service.
@@ -192,7 +444,35 @@ private:
      * @param service Reference to the service configuration.
      * @return service_state The current state of the service (ACTIVE, INACTIVE, or ERROR).
      */
-    service_state get_service_status(const svc_config& service);
+    service_state query_service_status(const svc_config& service);
+
+    /**
+     * @brief Retrieves the status of a service, at most once per pass of the monitor loop.
+     * 
+     * The answer is memoized until the pass ends, the handler submits an action for the
+     * service, or systemd reports a change of its state.
+     * 
+     * @param index The index of the service.
+     */
+    service_state get_service_status( size_t index );
+
+    /**
+     * @brief Starts a pass of the monitor loop with an empty status memo.
+     * 
+     * Nothing is queried yet; the first status needed of a service that is not
+     * watched fills the memo through `fill_status_memo`.
+     */
+    void begin_status_pass( );
+
+    /**
+     * @brief Queries all services that are not watched in bulk, one D-Bus call for all of them.
+     */
+    void fill_status_memo( );
+
+    /**
+     * @brief Drops the memoized status of a service.
+     */
+    void invalidate_status( size_t index );
 
 #ifdef USE_HTTP_DAY_STATUS
     /**
@@ -200,10 +480,13 @@ private:
      * 
      * This function makes an HTTP GET request to retrieve the trading day status. 
      * It retries up to 10 times with an exponential backoff if the request fails.
+     * Safe to call off the monitor loop thread; only `_is_working_day` is updated.
      * 
+     * @param date The date to check, as kept in `_last_date`.
+     * @param sleep_for Waits between retries; returns 0 to give up.
      * @return int Returns 1 if the request succeeds, or 0 if all retries fail.
      */
-    int load_day_status();
+    int load_day_status( const std::string& date, const std::function<int( long )>& sleep_for );
 
     /**
      * @brief Loads the last trade date from the cache and determines the working day status.
@@ -248,17 +531,50 @@ public:
     std::shared_ptr<svc_logger> _logger; ///< Logger instance for logging service activity.
 
 private:
-    bool _is_working_day;  ///< Indicates whether the current day is a working day.
+    std::atomic<bool> _is_working_day{ false };  ///< Indicates whether the current day is a working day.
+    std::atomic<bool> _day_status_pending{ false }; ///< The day's status is being loaded in the background.
+    bool _day_switch_failed = false; ///< The background day switch failed; the monitor loop exits.
+    bool _day_pipeline_deferred = false; ///< The day switch stages wait for a run in progress to be drained.
     std::string _last_date; ///< Stores the last recorded date.
-    std::future<void> _future; ///< Handles asynchronous operations.
 #ifdef USE_HTTP_DAY_STATUS
     http_client* _http = nullptr; ///< HTTP client for server communication.
 #endif //!USE_HTTP_DAY_STATUS
     std::atomic<int> _exit_flag = 0; ///< Flag to indicate service exit status.
     dust_cleaner_t* _cleaner = nullptr;
-    std::vector<svc_config*> _services; ///< List of service configurations.
-    service_manager_t* _svc_manager = nullptr; ///< Pointer to the service manager instance.
-    std::shared_ptr<std::promise<void>> _promise; ///< Promise object for managing async operations.
+    service_table_t _services; ///< Service configurations, hot schedule rows apart from the names.
+    service_scheduler_t _scheduler; ///< Upcoming schedule boundaries of all services.
+    service_registry_t _registry; ///< Service name index and dependency graph.
+    handler_config _handler_config; ///< Options of the handler itself.
+    service_backend_factory _backend_factory; ///< Creates the service manager connections.
+    service_backend_t* _svc_manager = nullptr; ///< Pointer to the service manager instance.
+    service_worker_pool_t* _workers = nullptr; ///< Performs start, stop and restart actions.
+    service_executor_t _executor; ///< Runs the restart cascades on the monitor loop thread.
+    bool _reload_requested = false; ///< Set by SIGHUP or a change of the config file, applied once idle.
+    latency_histogram_t _tick_lag; ///< How late the loop woke up for its deadline, for the current day.
+    latency_histogram_t _tick_duration; ///< Work time of each loop pass, for the current day.
+    std::mt19937 _jitter{ std::random_device{ }( ) }; ///< Spreads the retries of services backing off.
+    service_snapshot_t _snapshot; ///< Runtime state persisted for a warm restart.
+    std::vector<signed char> _status_memo; ///< Per service status of the current pass, -1 if not queried yet.
+    std::vector<unsigned char> _status_queries; ///< Per service queries in the current pass.
+    bool _status_bulk_pending = false; ///< The bulk query of the current pass did not run yet.
+    uint64_t _status_query_total = 0; ///< Status queries made, bulk ones counted per service.
+    uint64_t _status_memo_hits = 0; ///< Status lookups answered by the memo.
+    unsigned _status_max_queries = 0; ///< Most queries of one service within one pass.
+    bool _state_dirty = false; ///< A transition happened since the last snapshot.
+    service_reactor_t _reactor; ///< Event loop of the monitor thread.
+    service_control_t _control; ///< Local control socket, served on `_reactor`.
+    metrics_server_t _metrics_server; ///< Optional Prometheus listener, served on `_reactor`.
+    background_pipeline_t _pipeline; ///< Day switch stages and dust cleans, off the monitor loop.
 };
 
+/**
+ * @brief Blocks SIGINT, SIGTERM, SIGHUP and SIGUSR1 in the calling thread.
+ * 
+ * The handler receives them through its event loop instead. Call this first thing
+ * in `main`, before any thread is started, so that every thread inherits the mask.
+ * 
+ * @return int Returns 1 on success, or -1 on failure.
+ */
+int _block_handler_signals( );
+
 #endif //!_fsys_svc_handler_h
\ No newline at end of file
@@ -0,0 +1,101 @@
+/*
+* Copyright FSys Tech Limited [FSys]. All rights reserved.
+*
+* This software owned by FSys Tech Limited [FSys] and is protected by copyright law
+* and international copyright treaties.
+*
+* Access to and use of the software is governed by the terms of the applicable FSys Software
+* Services Agreement (the Agreement) and Customer end user license agreements granting
+* a non-assignable, non-transferable and non-exclusive license to use the software
+* for it's own data processing purposes under the terms defined in the Agreement.
+*
+* Except as otherwise granted within the terms of the Agreement, copying or reproduction of any part
+* of this source code or associated reference material to any other location for further reproduction
+* or redistribution, and any amendments to this copyright notice, are expressly prohibited.
+*
+* Any reproduction or redistribution for sale or hiring of the Software not in accordance with
+* the terms of the Agreement is a violation of copyright law.
+*/
+// 4:45 PM 10/17/2026
+// by Rajib Chy
+
+#ifdef _MSC_VER
+#pragma once
+#endif//_MSC_VER
+
+#ifndef _fsys_svc_histogram_h
+#define _fsys_svc_histogram_h
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <cstdint>
+
+/**
+ * @class latency_histogram_t
+ * @brief Lock-free log-linear histogram of durations in microseconds, in the style of HdrHistogram.
+ *
+ * Every power of two is split into 32 linear sub-buckets, so a recorded value is
+ * kept within about 3% of its true value from 1us up to 19 hours (larger values
+ * are clamped). Recording is a few relaxed atomic increments; percentiles may be
+ * read from any thread while values are recorded.
+ */
+class latency_histogram_t {
+public:
+    using duration = std::chrono::steady_clock::duration;
+
+    /**
+     * @brief Records one duration; negative durations are recorded as 0.
+     */
+    void record( duration value );
+
+    /**
+     * @brief Gets the number of recorded values.
+     */
+    uint64_t count( ) const;
+
+    /**
+     * @brief Gets the largest recorded value, in microseconds.
+     */
+    uint64_t max( ) const;
+
+    /**
+     * @brief Gets the value below or at which `percentile` percent of the values fall.
+     *
+     * @param percentile 0 to 100, e.g. 99.9.
+     * @return The highest value equivalent to that bucket in microseconds, or 0 when empty.
+     */
+    uint64_t percentile( double percentile ) const;
+
+    /**
+     * @brief Renders "count p50 p90 p99 p99.9 max", in microseconds.
+     */
+    std::string summary( ) const;
+
+    /**
+     * @brief Starts a new window; values recorded concurrently may fall into either one.
+     */
+    void reset( );
+
+    static constexpr int SUB_BUCKET_BITS = 5;
+    static constexpr uint64_t SUB_BUCKETS = 1ull << SUB_BUCKET_BITS;
+    static constexpr int MAX_MAGNITUDE = 36; ///< Values clamp at 2^36 - 1 us.
+    static constexpr size_t BUCKETS = 2 * SUB_BUCKETS + ( MAX_MAGNITUDE - SUB_BUCKET_BITS - 1 ) * SUB_BUCKETS;
+
+private:
+    std::atomic<uint64_t> _counts[BUCKETS]{ }; ///< Per bucket counts.
+    std::atomic<uint64_t> _total{ 0 }; ///< Sum of `_counts`.
+    std::atomic<uint64_t> _max{ 0 }; ///< Largest value recorded.
+};
+
+/**
+ * @brief Maps a value in microseconds onto its bucket of `latency_histogram_t`.
+ */
+size_t _latency_bucket_index( uint64_t value );
+
+/**
+ * @brief Gets the highest value in microseconds that maps onto `index`.
+ */
+uint64_t _latency_bucket_highest( size_t index );
+
+#endif //!_fsys_svc_histogram_h
@@ -0,0 +1,126 @@
+/*
+* Copyright FSys Tech Limited [FSys]. All rights reserved.
+*
+* This software owned by FSys Tech Limited [FSys] and is protected by copyright law
+* and international copyright treaties.
+*
+* Access to and use of the software is governed by the terms of the applicable FSys Software
+* Services Agreement (the Agreement) and Customer end user license agreements granting
+* a non-assignable, non-transferable and non-exclusive license to use the software
+* for it's own data processing purposes under the terms defined in the Agreement.
+*
+* Except as otherwise granted within the terms of the Agreement, copying or reproduction of any part
+* of this source code or associated reference material to any other location for further reproduction
+* or redistribution, and any amendments to this copyright notice, are expressly prohibited.
+*
+* Any reproduction or redistribution for sale or hiring of the Software not in accordance with
+* the terms of the Agreement is a violation of copyright law.
+*/
+// 9:12 AM 10/16/2026
+// by Rajib Chy
+
+#ifdef _MSC_VER
+#pragma once
+#endif//_MSC_VER
+
+#ifndef _fsys_svc_job_h
+#define _fsys_svc_job_h
+
+#include <string>
+#include <vector>
+#include <mutex>
+#include <functional>
+#include <condition_variable>
+
+/**
+ * @enum job_result
+ * @brief Result of a systemd job as reported by the `JobRemoved` signal.
+ */
+enum class job_result {
+    PENDING,    ///< The job has not finished yet.
+    DONE,       ///< The job finished successfully.
+    CANCELED,   ///< The job was canceled before it finished.
+    TIMEOUT,    ///< The job timed out.
+    FAILED,     ///< The job failed.
+    DEPENDENCY, ///< A job this job depended on failed.
+    SKIPPED     ///< The job was skipped because it did not apply to the unit's current state.
+};
+
+/**
+ * @class service_job_t
+ * @brief Handle of a systemd job queued by `StartUnit`, `StopUnit` or `RestartUnit`.
+ *
+ * The job completes when systemd removes it, i.e. when the matching `JobRemoved`
+ * signal arrives. Completion can be awaited or observed through callbacks.
+ */
+class service_job_t {
+public:
+    /**
+     * @brief Constructs a pending job.
+     *
+     * @param job_path The job object path returned by systemd.
+     */
+    explicit service_job_t( const std::string& job_path );
+
+    /**
+     * @brief Gets the job object path.
+     */
+    const std::string& get_path( ) const;
+
+    /**
+     * @brief Checks whether the job has finished.
+     */
+    bool is_done( ) const;
+
+    /**
+     * @brief Gets the job result, `job_result::PENDING` while the job is running.
+     */
+    job_result get_result( ) const;
+
+    /**
+     * @brief Waits for the job to finish.
+     *
+     * @param ms The maximum number of milliseconds to wait.
+     * @return The job result, or `job_result::PENDING` if the wait timed out.
+     */
+    job_result wait( long ms );
+
+    /**
+     * @brief Registers a callback invoked once the job finishes.
+     *
+     * If the job already finished, the callback is invoked immediately on the calling
+     * thread, otherwise on the thread that completes the job.
+     *
+     * @param callback The callback receiving the job result.
+     */
+    void on_complete( std::function<void( job_result )> callback );
+
+    /**
+     * @brief Completes the job; later calls are ignored.
+     *
+     * @param result The job result.
+     */
+    void complete( job_result result );
+
+private:
+    std::string _path; ///< The job object path.
+    job_result _result = job_result::PENDING; ///< The job result.
+    mutable std::mutex _mutex; ///< Guards `_result` and `_callbacks`.
+    std::condition_variable _cv; ///< Signalled when the job completes.
+    std::vector<std::function<void( job_result )>> _callbacks; ///< Completion callbacks.
+};
+
+/**
+ * @brief Converts the result string of a `JobRemoved` signal to a job result.
+ *
+ * @param result The result string (e.g. "done", "failed").
+ * @return The matching job result, `job_result::FAILED` for unknown strings.
+ */
+job_result _to_job_result( const std::string& result );
+
+/**
+ * @brief Gets the systemd name of a job result (e.g. "done").
+ */
+const char* _job_result_name( job_result result );
+
+#endif //!_fsys_svc_job_h
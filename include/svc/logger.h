@@ -31,6 +31,7 @@
 #include <sstream>
 #include <fstream>
 #include <memory>
+#include <mutex>
 
 #ifndef APP_VERSION
 #define APP_VERSION "3.0.10.200"
@@ -54,6 +55,7 @@ constexpr int SVC_LOGGER_ERROR = 3;  ///< Log level for error messages
  *
  * The svc_logger class handles writing logs to a file with different severity levels.
  * It supports variadic templates for formatted messages and ensures efficient file writing.
+ * All members may be called from any thread; each message is written as a whole.
  */
 class svc_logger {
 public:
@@ -199,6 +201,7 @@ private:
     size_t _write_byte = 0;            ///< Total bytes written
     size_t _need_flush = 0;            ///< Buffer threshold for flushing
     std::shared_ptr<std::ofstream> _out; ///< Log file output stream
+    std::recursive_mutex _mutex;       ///< Serializes writers; `renew` re-enters through `write`
 };
 
 
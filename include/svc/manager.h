@@ -27,7 +27,17 @@
 #include <iostream>
 #include <memory>
 #include <cstring>
+#include <cstdint>
+#include <list>
+#include <deque>
+#include <map>
+#include <vector>
+#include <mutex>
+#include <functional>
+#include <unordered_map>
 #include <sdbus-c++/sdbus-c++.h>
+#include <svc/job.h>
+#include <svc/backend.h>
 
 /**
  * @class service_manager_t
@@ -36,12 +46,47 @@
  * The `service_manager_t` class provides an interface for interacting with systemd services.
  * It allows starting, stopping, restarting services, and querying their status using D-Bus.
  */
-class service_manager_t {
+class service_manager_t : public service_backend_t {
 public:
     /**
      * @brief Constructs the service manager and establishes a D-Bus connection.
+     *
+     * @param external_loop `false` to dispatch signals on a background thread, `true` if
+     *        the owner dispatches them from its own event loop (see `get_poll_data`).
+     */
+    explicit service_manager_t( bool external_loop = false );
+
+    /**
+     * @brief Constructs the service manager on the bus at an address instead of the system bus.
+     *
+     * Meant for a private `dbus-daemon` serving a stand-in `org.freedesktop.systemd1`,
+     * see `mock_systemd_t`.
+     *
+     * @param bus_address The D-Bus address (e.g. "unix:path=/tmp/dbus-test"), empty for the system bus.
+     * @param external_loop As for the system bus constructor.
+     */
+    service_manager_t( const std::string& bus_address, bool external_loop );
+
+    /**
+     * @brief Stops the D-Bus event loop thread and releases the connection.
+     */
+    ~service_manager_t( ) override;
+
+    /**
+     * @brief Gets the descriptor, events and timeout the connection waits for.
+     *
+     * Only meaningful with an external loop; query it again before every wait.
+     */
+    backend_poll_data get_poll_data( ) const override;
+
+    /**
+     * @brief Dispatches every message pending on the connection.
+     *
+     * Call from the external loop once the connection's descriptor is ready or its timeout passed.
+     *
+     * @return The number of messages dispatched.
      */
-    service_manager_t( );
+    int process_pending( ) override;
 
     /**
      * @brief Starts a systemd service.
@@ -51,6 +96,15 @@ public:
      */
     int start( const std::string& serviceName );
 
+    /**
+     * @brief Starts a systemd service and returns the queued job.
+     *
+     * @param serviceName The name of the service to start (e.g., "example.service").
+     * @param job Receives the job handle, which completes when systemd reports `JobRemoved`.
+     * @return 1 if the start job was queued successfully, or -1 on failure.
+     */
+    int start( const std::string& serviceName, std::shared_ptr<service_job_t>& job ) override;
+
     /**
      * @brief Stops a systemd service.
      *
@@ -59,6 +113,15 @@ public:
      */
     int stop( const std::string& serviceName );
 
+    /**
+     * @brief Stops a systemd service and returns the queued job.
+     *
+     * @param serviceName The name of the service to stop (e.g., "example.service").
+     * @param job Receives the job handle, which completes when systemd reports `JobRemoved`.
+     * @return 1 if the stop job was queued successfully, or -1 on failure.
+     */
+    int stop( const std::string& serviceName, std::shared_ptr<service_job_t>& job ) override;
+
     /**
      * @brief Restarts a systemd service.
      *
@@ -67,6 +130,38 @@ public:
      */
     int restart( const std::string& serviceName );
 
+    /**
+     * @brief Restarts a systemd service and returns the queued job.
+     *
+     * @param serviceName The name of the service to restart (e.g., "example.service").
+     * @param job Receives the job handle, which completes when systemd reports `JobRemoved`.
+     * @return 1 if the restart job was queued successfully, or -1 on failure.
+     */
+    int restart( const std::string& serviceName, std::shared_ptr<service_job_t>& job ) override;
+
+    /**
+     * @brief Performs several unit operations with pipelined calls.
+     *
+     * Every call is sent before the first reply is awaited, so a batch costs about one
+     * round-trip plus systemd's processing time instead of one round-trip per operation.
+     * A `ResetFailedUnit` requested by `unit_request::reset_failed` is sent right before
+     * its operation, which systemd handles in order; its own failure is ignored.
+     * Replies are dispatched by the background event loop; with an external loop the
+     * operations are performed one after another.
+     *
+     * @param requests The operations; each one receives its status, job and error.
+     * @return 1 if every job was queued, or -1 if at least one call failed.
+     */
+    int call_many( std::vector<unit_request>& requests ) override;
+
+    /**
+     * @brief Resets the "failed" state of a unit, including its start rate limit (`ResetFailedUnit`).
+     *
+     * @param serviceName The name of the service (e.g., "example.service").
+     * @return 1 on success, or -1 on failure.
+     */
+    int reset_failed( const std::string& serviceName ) override;
+
 	/**
 	 * @brief Retrieves the status of a systemd service.
 	 *
@@ -84,12 +179,72 @@ public:
 	 */
 	int get_status( const std::string& serviceName, std::string& result );
 
+    /**
+     * @brief Retrieves the typed status of a systemd service in a single `GetAll` call.
+     *
+     * The properties of the `Unit` and `Service` interfaces are read together.
+     *
+     * @param serviceName The name of the service (e.g., "example.service").
+     * @param status Receives the status; reset to its defaults ("inactive") on failure.
+     * @return 1 if the status is retrieved successfully, or -1 on failure.
+     */
+    int get_status( const std::string& serviceName, unit_status& status ) override;
+
+    /**
+     * @brief Retrieves the status of several systemd services in a single `ListUnitsByNames` call.
+     *
+     * Only `ActiveState` and `SubState` are filled in, the other fields keep their defaults.
+     *
+     * @param serviceNames The names of the services (e.g., "example.service").
+     * @param results Receives one status per name, in the same order. Names unknown
+     *                to systemd are reported as "inactive".
+     * @return 1 if the statuses are retrieved successfully, or -1 on failure.
+     */
+    int get_status_many( const std::vector<std::string>& serviceNames, std::vector<unit_status>& results ) override;
+
+    /**
+     * @brief Starts tracking the state of a unit through `PropertiesChanged` signals.
+     *
+     * The current status is read once, afterwards the in-memory state table is kept
+     * up to date by systemd's change notifications.
+     *
+     * @param serviceName The name of the service (e.g., "example.service").
+     * @return 1 if the unit is tracked, or -1 on failure.
+     */
+    int watch( const std::string& serviceName ) override;
+
+    /**
+     * @brief Stops tracking the state of a unit.
+     *
+     * @param serviceName The name of the service (e.g., "example.service").
+     * @return 1 if the unit was tracked, or 0 if it was not.
+     */
+    int unwatch( const std::string& serviceName ) override;
+
+    /**
+     * @brief Reads the status of a watched unit from the in-memory state table.
+     *
+     * No D-Bus call is made.
+     *
+     * @param serviceName The name of the service (e.g., "example.service").
+     * @param status Receives the last known status.
+     * @return 1 if the unit is watched, or 0 if it is not (use `get_status` instead).
+     */
+    int get_cached_status( const std::string& serviceName, unit_status& status ) override;
+
+    /**
+     * @brief Sets the callback notified about `ActiveState` changes of watched units.
+     *
+     * @param listener The callback, replaces any previous one.
+     */
+    void set_state_listener( state_listener listener ) override;
+
     /**
      * @brief Gets the last error message.
      *
      * @return A C-string representing the last error message.
      */
-    const char* get_last_error( );
+    const char* get_last_error( ) override;
 
 private:
     /**
@@ -106,13 +261,101 @@ private:
      * @param method The method name to call (e.g., "StartUnit").
      * @param serviceName The name of the service (e.g., "example.service").
      * @param mode The mode for the operation (e.g., "replace").
-     * @return 0 if the method call succeeds, or -1 on failure.
+     * @param job Receives the handle of the job queued by systemd.
+     * @return 1 if the method call succeeds, or -1 on failure.
+     */
+    int call_systemd_method( const std::string& method, const std::string& serviceName, const std::string& mode, std::shared_ptr<service_job_t>& job );
+
+    /**
+     * @brief Creates the handle of a queued job and registers it for `JobRemoved`.
+     *
+     * If the signal already arrived before the method reply was processed, the
+     * handle is completed right away.
+     *
+     * @param job_path The job object path returned by systemd.
+     * @return The job handle.
+     */
+    std::shared_ptr<service_job_t> track_job( const sdbus::ObjectPath& job_path );
+
+    /**
+     * @brief Completes a tracked job, called for every `JobRemoved` signal.
+     *
+     * @param job_path The job object path.
+     * @param result The result string of the signal (e.g. "done").
+     */
+    void complete_job( const sdbus::ObjectPath& job_path, const std::string& result );
+
+    /**
+     * @brief Returns the proxy of a unit object, creating it on first use.
+     *
+     * Unit proxies are kept in a bounded LRU cache keyed by object path, so
+     * repeated status checks of the same unit reuse one proxy. Once the cache
+     * exceeds its capacity the least recently used proxy is released.
+     *
+     * @param object_path The unit object path returned by `LoadUnit`.
+     * @return A reference to the cached unit proxy.
+     */
+    sdbus::IProxy& get_unit_proxy( const sdbus::ObjectPath& object_path );
+
+    /**
+     * @brief Resolves the object path of a unit, calling `LoadUnit` only on a cache miss.
+     *
+     * @param service_name The name of the service (e.g., "example.service").
+     * @param object_path Receives the unit object path.
+     * @throws sdbus::Error If `LoadUnit` fails.
      */
-    int call_systemd_method( const std::string& method, const std::string& serviceName, const std::string& mode );
+    void load_unit_path( const std::string& service_name, sdbus::ObjectPath& object_path );
+
+    /**
+     * @brief Subscribes to systemd manager signals that invalidate the unit path cache.
+     *
+     * `UnitNew` and `UnitRemoved` drop the affected unit, `Reloading` drops every unit.
+     */
+    void subscribe_unit_signals( );
+
+    /**
+     * @brief Drops a unit from the path cache.
+     *
+     * @param service_name The name of the service (e.g., "example.service").
+     */
+    void forget_unit_path( const std::string& service_name );
+
+    /**
+     * @brief Updates the state table entry of a watched unit.
+     *
+     * Does nothing for units that are not watched. The state listener is notified
+     * when the `ActiveState` changed.
+     *
+     * @param service_name The name of the service (e.g., "example.service").
+     * @param update Applies the known fields to the entry, called under the state table lock.
+     */
+    void set_unit_state( const std::string& service_name, const std::function<void( unit_status& )>& update );
 
 private:
+    /**
+     * @brief State table entry of a watched unit.
+     */
+    struct unit_state_entry {
+        unit_status status; ///< Last known status.
+        std::unique_ptr<sdbus::IProxy> proxy; ///< Dedicated proxy holding the `PropertiesChanged` subscription.
+    };
+
+    using unit_proxy_entry = std::pair<std::string, std::unique_ptr<sdbus::IProxy>>;
+
     std::string _last_error; ///< Stores the last error message encountered.
     std::unique_ptr<sdbus::IConnection> _connection; ///< The D-Bus connection instance.
+    bool _external_loop = false; ///< Signals are dispatched by the owner instead of a background thread.
+    std::unique_ptr<sdbus::IProxy> _manager_proxy; ///< Long-lived proxy of `/org/freedesktop/systemd1`.
+    std::list<unit_proxy_entry> _unit_proxies; ///< Unit proxies, most recently used first.
+    std::unordered_map<std::string, std::list<unit_proxy_entry>::iterator> _unit_proxy_index; ///< Object path to `_unit_proxies` entry.
+    std::mutex _unit_path_mutex; ///< Guards `_unit_paths`, signals arrive on the event loop thread.
+    std::unordered_map<std::string, sdbus::ObjectPath> _unit_paths; ///< Service name to unit object path.
+    std::mutex _unit_state_mutex; ///< Guards `_unit_states` and `_state_listener`.
+    std::unordered_map<std::string, unit_state_entry> _unit_states; ///< Service name to last known state of watched units.
+    state_listener _state_listener; ///< Notified when a watched unit changes its `ActiveState`.
+    std::mutex _job_mutex; ///< Guards `_pending_jobs` and `_finished_jobs`.
+    std::unordered_map<std::string, std::shared_ptr<service_job_t>> _pending_jobs; ///< Job path to jobs awaiting `JobRemoved`.
+    std::deque<std::pair<std::string, job_result>> _finished_jobs; ///< Recent `JobRemoved` signals of jobs not tracked yet.
 };
 
 /**
@@ -126,4 +369,16 @@ private:
  */
 void _normalized_service_name( std::string& serviceName );
 
+/**
+ * @brief Creates a `service_manager_t` on the system bus, the default `service_backend_factory`.
+ */
+std::unique_ptr<service_backend_t> _create_system_backend( bool external_loop );
+
+/**
+ * @brief Gets a factory of `service_manager_t` connections to the bus at an address.
+ *
+ * @param bus_address The D-Bus address, empty for the system bus.
+ */
+service_backend_factory _create_bus_backend_factory( const std::string& bus_address );
+
 #endif //!_fsys_svc_manager_h
\ No newline at end of file
@@ -0,0 +1,203 @@
+/*
+* Copyright FSys Tech Limited [FSys]. All rights reserved.
+*
+* This software owned by FSys Tech Limited [FSys] and is protected by copyright law
+* and international copyright treaties.
+*
+* Access to and use of the software is governed by the terms of the applicable FSys Software
+* Services Agreement (the Agreement) and Customer end user license agreements granting
+* a non-assignable, non-transferable and non-exclusive license to use the software
+* for it's own data processing purposes under the terms defined in the Agreement.
+*
+* Except as otherwise granted within the terms of the Agreement, copying or reproduction of any part
+* of this source code or associated reference material to any other location for further reproduction
+* or redistribution, and any amendments to this copyright notice, are expressly prohibited.
+*
+* Any reproduction or redistribution for sale or hiring of the Software not in accordance with
+* the terms of the Agreement is a violation of copyright law.
+*/
+// 2:10 PM 10/17/2026
+// by Rajib Chy
+
+#ifdef _MSC_VER
+#pragma once
+#endif//_MSC_VER
+
+#ifndef _fsys_svc_metrics_h
+#define _fsys_svc_metrics_h
+
+#include <map>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <cstdint>
+#include <unordered_map>
+#include <svc/reactor.h>
+
+/**
+ * @class metric_counter_t
+ * @brief Monotonic counter, safe to increment from any thread.
+ */
+class metric_counter_t {
+public:
+    void add( uint64_t value = 1 );
+
+    uint64_t get( ) const;
+
+private:
+    std::atomic<uint64_t> _value{ 0 };
+};
+
+/**
+ * @class metric_histogram_t
+ * @brief Duration histogram with fixed buckets, safe to observe from any thread.
+ *
+ * Buckets span 100us to 10s, which covers a D-Bus round trip as well as a stalled tick.
+ */
+class metric_histogram_t {
+public:
+    using duration = std::chrono::steady_clock::duration;
+
+    void observe( duration value );
+
+    /**
+     * @brief Appends the `_bucket`, `_sum` and `_count` samples in text exposition format.
+     */
+    void render( const std::string& name, const std::string& labels, std::string& out ) const;
+
+    static constexpr size_t BUCKETS = 11;
+
+private:
+    std::atomic<uint64_t> _buckets[BUCKETS + 1]{ }; ///< Per bucket counts, the last one is +Inf.
+    std::atomic<uint64_t> _sum_ns{ 0 }; ///< Sum of the observed durations.
+};
+
+/**
+ * @class metric_timer_t
+ * @brief Observes the time from construction to destruction, including exceptional exits.
+ */
+class metric_timer_t {
+public:
+    explicit metric_timer_t( metric_histogram_t& histogram );
+
+    ~metric_timer_t( );
+
+    metric_timer_t( const metric_timer_t& ) = delete;
+    metric_timer_t& operator=( const metric_timer_t& ) = delete;
+
+private:
+    metric_histogram_t& _histogram;
+    std::chrono::steady_clock::time_point _start;
+};
+
+/**
+ * @class service_metrics_t
+ * @brief Process wide registry of the manager's counters and histograms.
+ *
+ * Metrics are created on first use and live as long as the process, so call sites may
+ * keep the returned reference. Lookups take a lock; hot paths should cache the reference.
+ */
+class service_metrics_t {
+public:
+    /**
+     * @brief Gets or creates a counter.
+     *
+     * @param name The metric name, ending in "_total".
+     * @param help The HELP text, taken from the first call for a name.
+     * @param labels Rendered label pairs (see `_metric_label`), or empty.
+     */
+    metric_counter_t& counter( const std::string& name, const char* help, const std::string& labels = std::string( ) );
+
+    /**
+     * @brief Gets or creates a duration histogram, rendered in seconds.
+     */
+    metric_histogram_t& histogram( const std::string& name, const char* help, const std::string& labels = std::string( ) );
+
+    /**
+     * @brief Renders every metric in Prometheus text exposition format (version 0.0.4).
+     */
+    void render( std::string& out ) const;
+
+private:
+    struct family {
+        std::string help;
+        bool is_histogram = false;
+        std::map<std::string, std::unique_ptr<metric_counter_t>> counters; ///< By labels.
+        std::map<std::string, std::unique_ptr<metric_histogram_t>> histograms; ///< By labels.
+    };
+
+    family& get_family( const std::string& name, const char* help, bool is_histogram );
+
+    mutable std::mutex _mutex; ///< Guards `_families`, not the metric values.
+    std::map<std::string, family> _families; ///< By metric name, sorted for a stable output.
+};
+
+/**
+ * @brief Gets the process wide metrics registry.
+ */
+service_metrics_t& _metrics( );
+
+/**
+ * @brief Renders one label pair, e.g. service="nginx.service", escaping the value.
+ */
+std::string _metric_label( const char* key, const std::string& value );
+
+/**
+ * @class metrics_server_t
+ * @brief Minimal HTTP/1.0 listener serving `GET /metrics` on the loopback interface.
+ *
+ * Runs on the monitor loop's reactor; every response closes its connection.
+ */
+class metrics_server_t {
+public:
+    explicit metrics_server_t( service_reactor_t& reactor );
+
+    ~metrics_server_t( );
+
+    metrics_server_t( const metrics_server_t& ) = delete;
+    metrics_server_t& operator=( const metrics_server_t& ) = delete;
+
+    /**
+     * @brief Binds 127.0.0.1:`port` and starts accepting connections.
+     *
+     * @return 1 on success, or -1 on failure.
+     */
+    int open( int port );
+
+    /**
+     * @brief Closes all connections and the listening socket.
+     */
+    void close( );
+
+    /**
+     * @brief Gets the last error message.
+     */
+    const char* get_last_error( );
+
+private:
+    struct connection {
+        std::string input; ///< Request bytes received so far.
+        std::string output; ///< Response bytes not yet written.
+    };
+
+    void accept_connections( );
+
+    void on_readable( int fd );
+
+    void respond( connection& conn );
+
+    void flush( int fd );
+
+    void drop( int fd );
+
+    void set_last_error( const char* action );
+
+    service_reactor_t& _reactor; ///< Dispatches the socket events.
+    int _listen_fd = -1; ///< The listening socket.
+    std::unordered_map<int, connection> _connections; ///< Open client connections.
+    std::string _last_error; ///< Stores the last error message.
+};
+
+#endif //!_fsys_svc_metrics_h
@@ -0,0 +1,177 @@
+/*
+* Copyright FSys Tech Limited [FSys]. All rights reserved.
+*
+* This software owned by FSys Tech Limited [FSys] and is protected by copyright law
+* and international copyright treaties.
+*
+* Access to and use of the software is governed by the terms of the applicable FSys Software
+* Services Agreement (the Agreement) and Customer end user license agreements granting
+* a non-assignable, non-transferable and non-exclusive license to use the software
+* for it's own data processing purposes under the terms defined in the Agreement.
+*
+* Except as otherwise granted within the terms of the Agreement, copying or reproduction of any part
+* of this source code or associated reference material to any other location for further reproduction
+* or redistribution, and any amendments to this copyright notice, are expressly prohibited.
+*
+* Any reproduction or redistribution for sale or hiring of the Software not in accordance with
+* the terms of the Agreement is a violation of copyright law.
+*/
+// 11:05 AM 10/16/2026
+// by Rajib Chy
+#ifdef _MSC_VER
+#pragma once
+#endif//_MSC_VER
+
+#ifndef _fsys_svc_mock_systemd_h
+#define _fsys_svc_mock_systemd_h
+#include <string>
+#include <memory>
+#include <vector>
+#include <map>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <unordered_map>
+#include <condition_variable>
+#include <sys/types.h>
+#include <sdbus-c++/sdbus-c++.h>
+#include <svc/backend.h>
+
+/**
+ * @class private_bus_t
+ * @brief A private `dbus-daemon --session`, so benchmarks never touch the host's buses.
+ *
+ * The daemon is terminated with this object, or with the process that started it.
+ */
+class private_bus_t {
+public:
+    private_bus_t( ) = default;
+
+    /**
+     * @brief Stops the daemon, see `stop`.
+     */
+    ~private_bus_t( );
+
+    private_bus_t( const private_bus_t& ) = delete;
+    private_bus_t& operator=( const private_bus_t& ) = delete;
+
+    /**
+     * @brief Launches the daemon and waits until it prints its address.
+     *
+     * @param daemon The `dbus-daemon` executable, looked up in `PATH` unless it contains a slash.
+     * @return 1 if the daemon is running, or -1 on failure.
+     */
+    int start( const std::string& daemon = "dbus-daemon" );
+
+    /**
+     * @brief Terminates the daemon and reaps it.
+     */
+    void stop( );
+
+    /**
+     * @brief Gets the address clients connect to, empty unless started.
+     */
+    const std::string& get_address( ) const;
+
+    /**
+     * @brief Gets the last error message.
+     *
+     * @return A C-string representing the last error message.
+     */
+    const char* get_last_error( );
+
+private:
+    pid_t _pid = -1; ///< The daemon, -1 if not running.
+    std::string _address; ///< The printed bus address.
+    std::string _last_error; ///< Stores the last error message encountered.
+};
+
+/**
+ * @class mock_systemd_t
+ * @brief Stand-in `org.freedesktop.systemd1` served on a private bus.
+ *
+ * Implements the part of the Manager interface `service_manager_t` uses: `LoadUnit`,
+ * `GetUnit`, `StartUnit`, `StopUnit`, `RestartUnit`, `ResetFailedUnit`, `ListUnitsByNames`,
+ * `Subscribe` and the `JobRemoved` signal; plus unit objects with the `Unit` and `Service`
+ * properties of `unit_status` and their `PropertiesChanged` signals. Every unit name exists
+ * and starts "inactive"; jobs always succeed after `job_delay`.
+ */
+class mock_systemd_t {
+public:
+    /**
+     * @brief Connects to the bus, takes the systemd name and serves it on a background thread.
+     *
+     * @param bus_address The bus to serve on, e.g. `private_bus_t::get_address`.
+     * @param job_delay Time from queuing a job until it finishes and `JobRemoved` is emitted.
+     * @throws sdbus::Error If the connection or the name cannot be acquired.
+     */
+    mock_systemd_t( const std::string& bus_address, std::chrono::milliseconds job_delay = std::chrono::milliseconds( 0 ) );
+
+    /**
+     * @brief Stops serving and releases the name.
+     */
+    ~mock_systemd_t( );
+
+    mock_systemd_t( const mock_systemd_t& ) = delete;
+    mock_systemd_t& operator=( const mock_systemd_t& ) = delete;
+
+    /**
+     * @brief Lets the main process of an active unit die, as if killed by SIGKILL.
+     *
+     * @param service_name The name of the service (e.g., "example.service").
+     */
+    void kill( const std::string& service_name );
+
+    /**
+     * @brief Gets the number of Manager method calls served.
+     */
+    uint64_t calls( ) const;
+
+private:
+    struct mock_unit {
+        sdbus::ObjectPath path; ///< The unit object path.
+        unit_status status; ///< Current properties.
+        std::unique_ptr<sdbus::IObject> object; ///< The exported unit object.
+    };
+
+    struct mock_job {
+        uint32_t id; ///< The job id.
+        sdbus::ObjectPath path; ///< The job object path.
+        std::string service_name; ///< The unit of the job.
+        unit_operation operation; ///< What the job does.
+    };
+
+    void register_manager( );
+
+    mock_unit& load_unit( const std::string& service_name );
+
+    sdbus::ObjectPath queue_job( unit_operation operation, const std::string& service_name );
+
+    void emit_unit_changed( const std::string& service_name );
+
+    void run( );
+
+    std::chrono::milliseconds _job_delay; ///< Time until a job finishes.
+    std::unique_ptr<sdbus::IConnection> _connection; ///< Connection owning the systemd name.
+    std::unique_ptr<sdbus::IObject> _manager; ///< The `/org/freedesktop/systemd1` object.
+    std::atomic<uint64_t> _calls = 0; ///< Manager method calls served.
+    std::mutex _mutex; ///< Guards the units and jobs.
+    std::condition_variable _cv; ///< Wakes the job thread.
+    bool _stopping = false; ///< Set by the destructor.
+    uint32_t _next_job = 1; ///< Id of the next job.
+    uint32_t _next_pid = 1000; ///< Main PID of the next started unit.
+    std::unordered_map<std::string, mock_unit> _units; ///< Loaded units by name.
+    std::multimap<std::chrono::steady_clock::time_point, mock_job> _jobs; ///< Running jobs by due time.
+    std::thread _thread; ///< Finishes the jobs.
+};
+
+/**
+ * @brief Escapes a unit name into an object path label, like systemd does.
+ *
+ * Letters and digits are kept, every other byte becomes `_` followed by two hex digits,
+ * e.g. "example.service" becomes "example_2eservice".
+ */
+std::string _escape_unit_path_label( const std::string& service_name );
+
+#endif //!_fsys_svc_mock_systemd_h
@@ -0,0 +1,124 @@
+/*
+* Copyright FSys Tech Limited [FSys]. All rights reserved.
+*
+* This software owned by FSys Tech Limited [FSys] and is protected by copyright law
+* and international copyright treaties.
+*
+* Access to and use of the software is governed by the terms of the applicable FSys Software
+* Services Agreement (the Agreement) and Customer end user license agreements granting
+* a non-assignable, non-transferable and non-exclusive license to use the software
+* for it's own data processing purposes under the terms defined in the Agreement.
+*
+* Except as otherwise granted within the terms of the Agreement, copying or reproduction of any part
+* of this source code or associated reference material to any other location for further reproduction
+* or redistribution, and any amendments to this copyright notice, are expressly prohibited.
+*
+* Any reproduction or redistribution for sale or hiring of the Software not in accordance with
+* the terms of the Agreement is a violation of copyright law.
+*/
+// 3:15 PM 10/18/2026
+// by Rajib Chy
+
+#ifdef _MSC_VER
+#pragma once
+#endif//_MSC_VER
+
+#ifndef _fsys_svc_pipeline_h
+#define _fsys_svc_pipeline_h
+
+#include <mutex>
+#include <atomic>
+#include <string>
+#include <vector>
+#include <thread>
+#include <utility>
+#include <functional>
+#include <condition_variable>
+
+/**
+ * @class background_pipeline_t
+ * @brief Runs a sequence of named stages on a background thread.
+ *
+ * One run at a time: `start` hands the stages over, the background thread runs them
+ * in order until one fails, then `notify` wakes the owning thread, whose `drain`
+ * invokes the completion callback. Stages sleep through `sleep_for`, so `stop`
+ * interrupts a run between stages or while it waits.
+ */
+class background_pipeline_t {
+public:
+    /**
+     * @brief A stage; returns 1 to continue with the next one, or 0 to abort the run.
+     */
+    using stage = std::function<int( )>;
+
+    /**
+     * @brief Invoked by `drain`, with status 1 if all stages completed, or 0 and the name of the failed stage.
+     */
+    using completion = std::function<void( int status, const std::string& failed_stage )>;
+
+    /**
+     * @param notify Invoked on the background thread when a run finished.
+     */
+    explicit background_pipeline_t( std::function<void( )> notify );
+
+    /**
+     * @brief Stops the pipeline, see `stop`.
+     */
+    ~background_pipeline_t( );
+
+    background_pipeline_t( const background_pipeline_t& ) = delete;
+    background_pipeline_t& operator=( const background_pipeline_t& ) = delete;
+
+    /**
+     * @brief Starts a run.
+     *
+     * @param stages Name and body of each stage, run in order.
+     * @param done Invoked by `drain` once the run finished.
+     * @return 1 if the run started, or 0 if the previous one was not drained yet or the pipeline is stopped.
+     */
+    int start( std::vector<std::pair<std::string, stage>> stages, completion done );
+
+    /**
+     * @brief Tells whether a run was started and its completion not drained yet.
+     */
+    bool is_running( ) const;
+
+    /**
+     * @brief Invokes the completion of a finished run on the calling thread.
+     *
+     * @return 1 if a completion ran, 0 otherwise.
+     */
+    int drain( );
+
+    /**
+     * @brief Sleeps within a stage.
+     *
+     * @return 1 after `ms` milliseconds, or 0 as soon as the pipeline is stopped.
+     */
+    int sleep_for( long ms );
+
+    /**
+     * @brief Interrupts the current run and joins the background thread.
+     *
+     * A stage in progress finishes first, unless it is sleeping; its completion is dropped.
+     */
+    void stop( );
+
+private:
+    void run( );
+
+    std::function<void( )> _notify; ///< Wakes the owning thread.
+    std::atomic<bool> _stopping = false; ///< Set once `stop` was called.
+    mutable std::mutex _mutex; ///< Guards the fields below.
+    std::condition_variable _cv; ///< Signalled on a new run and on stop.
+    std::vector<std::pair<std::string, stage>> _stages; ///< Stages of the pending run.
+    completion _done; ///< Completion of the current run.
+    bool _running = false; ///< A run was started and not drained.
+    bool _finished = false; ///< The current run finished.
+    bool _pending = false; ///< `_stages` wait for the background thread.
+    int _status = 0; ///< Status of the finished run.
+    std::string _failed_stage; ///< Stage that aborted the finished run.
+    std::thread _thread; ///< Started with the first run.
+};
+
+#endif //!_fsys_svc_pipeline_h
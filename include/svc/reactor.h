@@ -0,0 +1,157 @@
+/*
+* Copyright FSys Tech Limited [FSys]. All rights reserved.
+*
+* This software owned by FSys Tech Limited [FSys] and is protected by copyright law
+* and international copyright treaties.
+*
+* Access to and use of the software is governed by the terms of the applicable FSys Software
+* Services Agreement (the Agreement) and Customer end user license agreements granting
+* a non-assignable, non-transferable and non-exclusive license to use the software
+* for it's own data processing purposes under the terms defined in the Agreement.
+*
+* Except as otherwise granted within the terms of the Agreement, copying or reproduction of any part
+* of this source code or associated reference material to any other location for further reproduction
+* or redistribution, and any amendments to this copyright notice, are expressly prohibited.
+*
+* Any reproduction or redistribution for sale or hiring of the Software not in accordance with
+* the terms of the Agreement is a violation of copyright law.
+*/
+// 6:10 PM 10/16/2026
+// by Rajib Chy
+
+#ifdef _MSC_VER
+#pragma once
+#endif//_MSC_VER
+
+#ifndef _fsys_svc_reactor_h
+#define _fsys_svc_reactor_h
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <unordered_map>
+
+/**
+ * @class service_reactor_t
+ * @brief epoll based event loop of the monitor thread.
+ *
+ * Multiplexes file descriptors registered by the owner with a timerfd for the
+ * next deadline and an eventfd through which other threads wake the loop. All
+ * callbacks run on the thread calling `poll`.
+ */
+class service_reactor_t {
+public:
+    using clock = std::chrono::steady_clock;
+    using fd_callback = std::function<void( uint32_t events )>;
+
+    /**
+     * @brief Creates the epoll instance, the deadline timer and the wake-up event.
+     * @throws std::runtime_error If one of them cannot be created.
+     */
+    service_reactor_t( );
+
+    /**
+     * @brief Closes the descriptors created by the reactor.
+     */
+    ~service_reactor_t( );
+
+    service_reactor_t( const service_reactor_t& ) = delete;
+    service_reactor_t& operator=( const service_reactor_t& ) = delete;
+
+    /**
+     * @brief Registers a descriptor; it stays owned by the caller.
+     *
+     * @param fd The descriptor.
+     * @param events The epoll events to wait for (e.g. `EPOLLIN`).
+     * @param callback Invoked with the ready events.
+     * @return 1 on success, or -1 on failure.
+     */
+    int add( int fd, uint32_t events, fd_callback callback );
+
+    /**
+     * @brief Changes the events a registered descriptor waits for.
+     *
+     * @return 1 on success, or -1 on failure.
+     */
+    int modify( int fd, uint32_t events );
+
+    /**
+     * @brief Unregisters a descriptor.
+     *
+     * @return 1 on success, or -1 on failure.
+     */
+    int remove( int fd );
+
+    /**
+     * @brief Delivers signals through a signalfd.
+     *
+     * The signals must already be blocked in every thread of the process,
+     * otherwise their default action runs instead.
+     *
+     * @param signals The signal numbers.
+     * @param callback Invoked with each received signal number.
+     * @return 1 on success, or -1 on failure.
+     */
+    int add_signals( const std::vector<int>& signals, std::function<void( int signal )> callback );
+
+    /**
+     * @brief Reports files written or moved into a directory through inotify.
+     *
+     * @param path The directory to watch.
+     * @param callback Invoked with the name of each changed file.
+     * @return 1 on success, or -1 on failure.
+     */
+    int add_directory_watch( const std::string& path, std::function<void( const std::string& name )> callback );
+
+    /**
+     * @brief Waits for events until `deadline` and dispatches them.
+     *
+     * Returns after the first batch of events, on a wake-up or at the deadline,
+     * whichever comes first.
+     *
+     * @param deadline The latest point of return; `clock::time_point::max()` waits for events only.
+     * @return 1 on events, wake-up or deadline, or 0 once `stop` was called.
+     */
+    int poll( clock::time_point deadline );
+
+    /**
+     * @brief Makes a running or the next `poll` return; safe to call from any thread.
+     */
+    void wake( );
+
+    /**
+     * @brief Makes every following `poll` return 0; safe to call from any thread.
+     */
+    void stop( );
+
+    /**
+     * @brief Checks whether `stop` was called.
+     */
+    bool is_stopped( ) const;
+
+    /**
+     * @brief Gets the last error message.
+     */
+    const char* get_last_error( );
+
+private:
+    void set_last_error( const char* action );
+
+    int _epoll_fd = -1; ///< The epoll instance.
+    int _timer_fd = -1; ///< Fires at the deadline of `poll`.
+    int _wake_fd = -1; ///< Written by `wake`.
+    std::vector<int> _owned_fds; ///< signalfd and inotify descriptors created by the reactor.
+    std::unordered_map<int, fd_callback> _callbacks; ///< Per registered descriptor.
+    std::atomic<bool> _stopped = false; ///< Set by `stop`.
+    std::string _last_error; ///< Stores the last error message.
+};
+
+/**
+ * @brief Converts `poll` events (e.g. of sd-bus) to epoll events.
+ */
+uint32_t _to_epoll_events( short events );
+
+#endif //!_fsys_svc_reactor_h
@@ -0,0 +1,107 @@
+/*
+* Copyright FSys Tech Limited [FSys]. All rights reserved.
+*
+* This software owned by FSys Tech Limited [FSys] and is protected by copyright law
+* and international copyright treaties.
+*
+* Access to and use of the software is governed by the terms of the applicable FSys Software
+* Services Agreement (the Agreement) and Customer end user license agreements granting
+* a non-assignable, non-transferable and non-exclusive license to use the software
+* for it's own data processing purposes under the terms defined in the Agreement.
+*
+* Except as otherwise granted within the terms of the Agreement, copying or reproduction of any part
+* of this source code or associated reference material to any other location for further reproduction
+* or redistribution, and any amendments to this copyright notice, are expressly prohibited.
+*
+* Any reproduction or redistribution for sale or hiring of the Software not in accordance with
+* the terms of the Agreement is a violation of copyright law.
+*/
+// 4:15 PM 10/16/2026
+// by Rajib Chy
+
+#ifdef _MSC_VER
+#pragma once
+#endif//_MSC_VER
+
+#ifndef _fsys_svc_registry_h
+#define _fsys_svc_registry_h
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <svc/config.h>
+
+/**
+ * @class service_registry_t
+ * @brief Name index and dependency graph of the configured services.
+ *
+ * Built once from the service list: service names are hashed to their index and
+ * the `dependent` lists are resolved to integer adjacency lists in both directions,
+ * so cascades walk the graph in O(edges) without string compares. A dependency
+ * cycle is rejected when the registry is built.
+ */
+class service_registry_t {
+public:
+    static constexpr size_t npos = static_cast<size_t>( -1 ); ///< Returned by `find` for unknown names.
+
+    /**
+     * @brief Builds the registry from the service list.
+     *
+     * Dependents that are not configured services are left out of the graph and
+     * reported through `unknown` as "service -> dependent".
+     *
+     * @param services The configured services; indexes refer to this list.
+     * @param unknown Receives the dependents that could not be resolved.
+     * @throws std::runtime_error If the dependency graph contains a cycle.
+     */
+    void build( const service_table_t& services, std::vector<std::string>& unknown );
+
+    /**
+     * @brief Removes all services.
+     */
+    void clear( );
+
+    /**
+     * @brief Gets the number of services.
+     */
+    size_t size( ) const;
+
+    /**
+     * @brief Looks up a service by name.
+     *
+     * @param service_name The normalized service name (e.g., "example.service").
+     * @return The index of the service, or `npos` if it is not configured.
+     */
+    size_t find( const std::string& service_name ) const;
+
+    /**
+     * @brief Gets the services that depend on a service.
+     */
+    const std::vector<size_t>& get_dependents( size_t index ) const;
+
+    /**
+     * @brief Gets the services a service depends on.
+     */
+    const std::vector<size_t>& get_dependencies( size_t index ) const;
+
+    /**
+     * @brief Splits the dependency graph below a service into topological levels.
+     *
+     * Level 0 holds the direct dependents of `root`, level `n + 1` the services
+     * depending on level `n`. A service reachable through several paths is placed on
+     * its deepest level, so every service it depends on sits on an earlier level.
+     *
+     * @param root The index of the service whose dependents are levelled.
+     * @param levels Receives the service indexes of each level.
+     */
+    void get_levels( size_t root, std::vector<std::vector<size_t>>& levels ) const;
+
+private:
+    std::unordered_map<std::string, size_t> _index; ///< Service name to index.
+    std::vector<std::vector<size_t>> _dependents; ///< Per service, the services depending on it.
+    std::vector<std::vector<size_t>> _dependencies; ///< Per service, the services it depends on.
+    std::vector<size_t> _order; ///< All services in topological order.
+};
+
+#endif //!_fsys_svc_registry_h
@@ -0,0 +1,117 @@
+/*
+* Copyright FSys Tech Limited [FSys]. All rights reserved.
+*
+* This software owned by FSys Tech Limited [FSys] and is protected by copyright law
+* and international copyright treaties.
+*
+* Access to and use of the software is governed by the terms of the applicable FSys Software
+* Services Agreement (the Agreement) and Customer end user license agreements granting
+* a non-assignable, non-transferable and non-exclusive license to use the software
+* for it's own data processing purposes under the terms defined in the Agreement.
+*
+* Except as otherwise granted within the terms of the Agreement, copying or reproduction of any part
+* of this source code or associated reference material to any other location for further reproduction
+* or redistribution, and any amendments to this copyright notice, are expressly prohibited.
+*
+* Any reproduction or redistribution for sale or hiring of the Software not in accordance with
+* the terms of the Agreement is a violation of copyright law.
+*/
+// 11:05 AM 10/16/2026
+// by Rajib Chy
+
+#ifdef _MSC_VER
+#pragma once
+#endif//_MSC_VER
+
+#ifndef _fsys_svc_scheduler_h
+#define _fsys_svc_scheduler_h
+
+#include <ctime>
+#include <cstddef>
+#include <vector>
+#include <queue>
+
+/**
+ * @enum schedule_event
+ * @brief Kind of schedule boundary of a service.
+ */
+enum class schedule_event {
+    START,   ///< The service's operational time range begins.
+    END,     ///< The service's operational time range ended.
+    RESTART, ///< The service's daily restart is due.
+    RETRY    ///< The backoff of a failing service expired.
+};
+
+/**
+ * @brief A schedule boundary of one service.
+ */
+struct schedule_entry {
+    std::time_t epoch = 0; /**< When the boundary is due. */
+    size_t service_index = 0; /**< Index of the service in the handler's service list. */
+    schedule_event event = schedule_event::START; /**< Kind of boundary. */
+};
+
+/**
+ * @class service_scheduler_t
+ * @brief Min-heap of upcoming schedule boundaries across all services.
+ *
+ * The monitor loop sleeps until `next_epoch()` and then pops every due entry.
+ * Each entry is popped exactly once, entries whose time already passed are
+ * popped on the next call, so a late wake-up catches up on missed boundaries.
+ */
+class service_scheduler_t {
+public:
+    /**
+     * @brief Removes all scheduled entries.
+     */
+    void clear( );
+
+    /**
+     * @brief Schedules a boundary.
+     *
+     * @param epoch When the boundary is due.
+     * @param service_index Index of the service in the handler's service list.
+     * @param event Kind of boundary.
+     */
+    void schedule( std::time_t epoch, size_t service_index, schedule_event event );
+
+    /**
+     * @brief Checks whether no boundary is scheduled.
+     */
+    bool empty( ) const;
+
+    /**
+     * @brief Gets the number of scheduled boundaries.
+     */
+    size_t size( ) const;
+
+    /**
+     * @brief Gets the time of the earliest scheduled boundary.
+     *
+     * @return The epoch of the earliest boundary, or 0 if none is scheduled.
+     */
+    std::time_t next_epoch( ) const;
+
+    /**
+     * @brief Pops the earliest boundary if it is due.
+     *
+     * @param now_time The current time.
+     * @param entry Receives the popped boundary.
+     * @return 1 if a due boundary was popped, 0 otherwise.
+     */
+    int pop_due( const std::time_t& now_time, schedule_entry& entry );
+
+private:
+    /**
+     * @brief Orders entries so the earliest one is on top of the heap.
+     */
+    struct later_first {
+        bool operator( )( const schedule_entry& a, const schedule_entry& b ) const {
+            return a.epoch > b.epoch;
+        }
+    };
+
+    std::priority_queue<schedule_entry, std::vector<schedule_entry>, later_first> _queue; ///< Upcoming boundaries, earliest first.
+};
+
+#endif //!_fsys_svc_scheduler_h
@@ -0,0 +1,128 @@
+/*
+* Copyright FSys Tech Limited [FSys]. All rights reserved.
+*
+* This software owned by FSys Tech Limited [FSys] and is protected by copyright law
+* and international copyright treaties.
+*
+* Access to and use of the software is governed by the terms of the applicable FSys Software
+* Services Agreement (the Agreement) and Customer end user license agreements granting
+* a non-assignable, non-transferable and non-exclusive license to use the software
+* for it's own data processing purposes under the terms defined in the Agreement.
+*
+* Except as otherwise granted within the terms of the Agreement, copying or reproduction of any part
+* of this source code or associated reference material to any other location for further reproduction
+* or redistribution, and any amendments to this copyright notice, are expressly prohibited.
+*
+* Any reproduction or redistribution for sale or hiring of the Software not in accordance with
+* the terms of the Agreement is a violation of copyright law.
+*/
+// 10:30 AM 10/18/2026
+// by Rajib Chy
+
+#ifdef _MSC_VER
+#pragma once
+#endif//_MSC_VER
+
+#ifndef _fsys_svc_snapshot_h
+#define _fsys_svc_snapshot_h
+
+#include <string>
+#include <cstdint>
+#include <svc/config.h>
+#include <svc/registry.h>
+
+/**
+ * @class service_snapshot_t
+ * @brief Runtime state of the services, persisted in a memory-mapped file for a warm restart.
+ *
+ * The file has a fixed layout: a header with magic, version, checksum and the date the
+ * per-day flags belong to, followed by one fixed size record per service keyed by name.
+ * Saving rewrites the records in place and publishes them by updating the checksum last,
+ * so a snapshot torn by a crash fails validation and is ignored.
+ */
+class service_snapshot_t {
+public:
+    ~service_snapshot_t( );
+
+    /**
+     * @brief Maps the snapshot file, creating it if missing.
+     *
+     * @param path The file path (e.g., "./svcm/state.dat").
+     * @return 1 on success, or -1 on failure.
+     */
+    int open( const std::string& path );
+
+    /**
+     * @brief Unmaps and closes the file.
+     */
+    void close( );
+
+    bool is_open( ) const;
+
+    /**
+     * @brief Restores the persisted state into `services`.
+     *
+     * Nothing is restored unless the snapshot is intact, has the current version and
+     * was taken on `date`. Records of services no longer configured are ignored.
+     *
+     * @param date The current date, as kept by the handler.
+     * @param registry Resolves record names to service indexes.
+     * @param services Receives `state`, `is_restarted` and the backoff fields.
+     * @return The number of services restored, or 0 if the snapshot is unusable.
+     */
+    int restore( const std::string& date, const service_registry_t& registry, service_table_t& services );
+
+    /**
+     * @brief Persists the state of all services, taken on `date`.
+     *
+     * Services with a name longer than the record allows are not persisted.
+     *
+     * @return 1 on success, or -1 if the file could not be grown.
+     */
+    int save( const std::string& date, const service_table_t& services );
+
+    /**
+     * @brief Gets the last error message.
+     */
+    const char* get_last_error( );
+
+    static constexpr uint32_t VERSION = 1;
+    static constexpr size_t MAX_NAME_LENGTH = 119;
+
+private:
+    struct header {
+        char magic[4]; ///< "SVCS".
+        uint32_t version; ///< Layout version, `VERSION`.
+        uint32_t checksum; ///< FNV-1a over everything after this field up to the last record.
+        uint32_t capacity; ///< Number of record slots in the file.
+        uint32_t count; ///< Number of records in use.
+        char date[12]; ///< Date the per-day flags belong to, NUL terminated.
+    };
+
+    struct record {
+        char name[MAX_NAME_LENGTH + 1]; ///< Service name, NUL terminated.
+        uint8_t state; ///< `service_state`.
+        uint8_t is_restarted; ///< Today's restart is done.
+        uint8_t reserved[2];
+        int32_t start_failures;
+        int64_t last_start_epoch;
+        int64_t retry_epoch;
+    };
+
+    int map( uint32_t capacity );
+
+    void unmap( );
+
+    uint32_t checksum( ) const;
+
+    record* records( ) const;
+
+    void set_last_error( const char* action );
+
+    int _fd = -1; ///< The snapshot file.
+    header* _header = nullptr; ///< The mapped file.
+    size_t _length = 0; ///< Mapped length in bytes.
+    std::string _last_error; ///< Stores the last error message.
+};
+
+#endif //!_fsys_svc_snapshot_h
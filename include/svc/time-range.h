@@ -39,8 +39,12 @@ class time_range_t {
 public:
     /**
      * @brief Constructor to initialize time range and start printing thread.
+     * 
+     * The times are parsed once here; `prepare` only maps them onto the current day.
+     * 
      * @param start_time Start time in "HH:MM:SS" format.
      * @param end_time End time in "HH:MM:SS" format.
+     * @throws std::runtime_error If a time string cannot be parsed.
      */
     time_range_t( const std::string& start_time, const std::string& end_time, const std::string& restart_time );
 
@@ -70,30 +74,45 @@ public:
     bool need_restart( const std::time_t& now_time ) const;
 
     /**
-     * @brief Prepares the time range by converting string representations of time 
-     *        into epoch values (time_t) for comparison.
+     * @brief Prepares the time range by converting the parsed times of day 
+     *        into today's epoch values (time_t) for comparison.
      * 
-     * This function checks whether the start or end time is empty or set to a 
-     * predefined "empty time" value. If so, it sets both `_start_epoch` and 
-     * `_end_epoch` to 0. Otherwise, it converts the start and end times from 
-     * string format to `tm` structures and then to epoch time.
+     * If the start or end time was empty or set to the predefined "empty time"
+     * value, both `_start_epoch` and `_end_epoch` are set to 0.
      */
     void prepare( );
 
     bool is_restart_supported( ) const;
 
+    /**
+     * @brief Checks whether another time range was configured with the same start, end and restart time.
+     */
+    bool equals( const time_range_t& other ) const;
+
+    /**
+     * @brief Gets today's start of the time range, or 0 for uninterrupted mode.
+     */
+    std::time_t get_start_epoch( ) const;
+
+    /**
+     * @brief Gets today's end of the time range, or 0 for uninterrupted mode.
+     */
+    std::time_t get_end_epoch( ) const;
+
+    /**
+     * @brief Gets today's restart time, or 0 if restart is not supported.
+     */
+    std::time_t get_restart_epoch( ) const;
+
     void print( std::shared_ptr<svc_logger>& logger ) const;
 
 private:
-    std::string _restart_time; ///< Re-Start time in "HH:MM:SS" format.
-    std::string _start_time;   ///< Start time in "HH:MM:SS" format.
-    std::string _end_time;     ///< End time in "HH:MM:SS" format.
-    //std::tm _start_tm;         ///< Parsed start time.
-    //std::tm _end_tm;           ///< Parsed end time.
     std::time_t _restart_epoch;  ///< Re-Start time as time_t for comparison.
     std::time_t _start_epoch;  ///< Start time as time_t for comparison.
     std::time_t _end_epoch;    ///< End time as time_t for comparison.
-    std::string _last_error;   ///< Stores the last error message.
+    int _restart_seconds;      ///< Re-Start time in seconds of the day, or -1 if not set.
+    int _start_seconds;        ///< Start time in seconds of the day, or -1 if not set.
+    int _end_seconds;          ///< End time in seconds of the day, or -1 if not set.
 };
 
 /**
@@ -119,4 +138,12 @@ void _get_current_date( std::string& result );
  */
 bool _is_valid_date( const std::string& date_str );
 
+/**
+ * @brief Gets the epoch of the next local midnight after a given time.
+ * 
+ * @param now_time The reference time.
+ * @return The epoch of 00:00:00 of the following local day.
+ */
+std::time_t _get_next_midnight( const std::time_t& now_time );
+
 #endif //!_fsys_svc_time_range_h
\ No newline at end of file
@@ -0,0 +1,167 @@
+/*
+* Copyright FSys Tech Limited [FSys]. All rights reserved.
+*
+* This software owned by FSys Tech Limited [FSys] and is protected by copyright law
+* and international copyright treaties.
+*
+* Access to and use of the software is governed by the terms of the applicable FSys Software
+* Services Agreement (the Agreement) and Customer end user license agreements granting
+* a non-assignable, non-transferable and non-exclusive license to use the software
+* for it's own data processing purposes under the terms defined in the Agreement.
+*
+* Except as otherwise granted within the terms of the Agreement, copying or reproduction of any part
+* of this source code or associated reference material to any other location for further reproduction
+* or redistribution, and any amendments to this copyright notice, are expressly prohibited.
+*
+* Any reproduction or redistribution for sale or hiring of the Software not in accordance with
+* the terms of the Agreement is a violation of copyright law.
+*/
+// 2:40 PM 10/16/2026
+// by Rajib Chy
+
+#ifdef _MSC_VER
+#pragma once
+#endif//_MSC_VER
+
+#ifndef _fsys_svc_worker_pool_h
+#define _fsys_svc_worker_pool_h
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <functional>
+#include <unordered_map>
+#include <condition_variable>
+#include <svc/job.h>
+#include <svc/backend.h>
+
+/**
+ * @enum service_action
+ * @brief Action a worker performs on a service.
+ */
+enum class service_action {
+    START,  ///< Start the service.
+    STOP,   ///< Stop the service.
+    RESTART, ///< Restart the service.
+    RETRY   ///< Reset the service's failed state, then start it.
+};
+
+/**
+ * @brief Outcome of an action, posted back to the submitting thread.
+ */
+struct action_result {
+    size_t service_index = 0; /**< Index the action was submitted for. */
+    service_action action = service_action::START; /**< The action performed. */
+    int status = 0; /**< 1 if systemd accepted the job, -1 if queuing it failed. */
+    job_result result = job_result::PENDING; /**< Job result, posted once the job finished. */
+    std::string job_path; /**< The systemd job object path, if queued. */
+    std::string error; /**< The error of the failed call if `status` is -1. */
+};
+
+/**
+ * @class service_worker_pool_t
+ * @brief Bounded pool of threads performing start, stop and restart actions.
+ *
+ * Each worker owns its own backend connection, e.g. its own D-Bus connection.
+ * A worker takes its share of the ready actions as one batch, sends their calls
+ * pipelined (see `service_manager_t::call_many`) and awaits their systemd jobs
+ * together, posting each result as its job finishes. Actions of the same service
+ * run one after another in submission order: a service stays busy until its job
+ * finished, even after the worker stopped waiting for it.
+ *
+ * Workers touch no handler state: results are queued and collected with `drain`
+ * on the submitting thread, which is woken through the notify callback.
+ */
+class service_worker_pool_t {
+public:
+    /**
+     * @brief Connects the workers and starts their threads.
+     *
+     * @param workers The number of worker threads, at least 1.
+     * @param job_wait_ms The maximum number of milliseconds a worker waits for the jobs of a batch
+     *        before it takes the next one; later results are posted when their jobs finish.
+     * @param backend_factory Creates the connection of each worker.
+     * @param notify Invoked on a worker thread whenever a result was posted.
+     * @throws Whatever `backend_factory` throws if a worker cannot connect.
+     */
+    service_worker_pool_t( size_t workers, long job_wait_ms, const service_backend_factory& backend_factory, std::function<void( )> notify );
+
+    /**
+     * @brief Stops the pool, see `stop`.
+     */
+    ~service_worker_pool_t( );
+
+    /**
+     * @brief Queues an action.
+     *
+     * @param service_index The index reported back in the result.
+     * @param service_name The normalized service name (e.g., "example.service").
+     * @param action The action to perform.
+     */
+    void submit( size_t service_index, const std::string& service_name, service_action action );
+
+    /**
+     * @brief Keeps submitted actions queued until `release`.
+     *
+     * Actions submitted in between are handed out together, so they are sent as
+     * pipelined batches instead of one call per wake-up.
+     */
+    void hold( );
+
+    /**
+     * @brief Hands out the actions queued since `hold`.
+     */
+    void release( );
+
+    /**
+     * @brief Moves all posted results into `results`.
+     *
+     * @param results Receives the results in completion order; cleared first.
+     * @return The number of results.
+     */
+    size_t drain( std::vector<action_result>& results );
+
+    /**
+     * @brief Stops the workers and joins their threads.
+     *
+     * Queued actions are dropped; a worker awaiting a job gives up within 100 ms.
+     */
+    void stop( );
+
+private:
+    struct action_request {
+        size_t service_index;
+        std::string service_name;
+        service_action action;
+    };
+
+    void run( size_t worker );
+
+    void perform( service_backend_t& manager, const std::vector<action_request>& batch );
+
+    void post( const action_request& request, action_result& result );
+
+    long _job_wait_ms; ///< Upper bound for awaiting one job.
+    std::function<void( )> _notify; ///< Wakes the submitting thread.
+    std::atomic<bool> _stopping = false; ///< Set once `stop` was called.
+    bool _held = false; ///< Ready actions are not handed out while set.
+    std::mutex _mutex; ///< Guards the queues and results.
+    std::condition_variable _cv; ///< Signalled when a service becomes ready.
+    std::unordered_map<size_t, std::deque<action_request>> _queues; ///< Per service, the running action first.
+    std::deque<size_t> _ready; ///< Services with a queued action and none running.
+    std::vector<action_result> _results; ///< Posted results not yet drained.
+    std::vector<std::unique_ptr<service_backend_t>> _managers; ///< One connection per worker.
+    std::vector<std::thread> _threads; ///< The worker threads.
+};
+
+/**
+ * @brief Gets the name of an action (e.g. "start").
+ */
+const char* _service_action_name( service_action action );
+
+#endif //!_fsys_svc_worker_pool_h
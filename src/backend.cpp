@@ -0,0 +1,71 @@
+/*
+* Copyright FSys Tech Limited [FSys]. All rights reserved.
+*
+* This software owned by FSys Tech Limited [FSys] and is protected by copyright law
+* and international copyright treaties.
+*
+* Access to and use of the software is governed by the terms of the applicable FSys Software
+* Services Agreement (the Agreement) and Customer end user license agreements granting
+* a non-assignable, non-transferable and non-exclusive license to use the software
+* for it's own data processing purposes under the terms defined in the Agreement.
+*
+* Except as otherwise granted within the terms of the Agreement, copying or reproduction of any part
+* of this source code or associated reference material to any other location for further reproduction
+* or redistribution, and any amendments to this copyright notice, are expressly prohibited.
+*
+* Any reproduction or redistribution for sale or hiring of the Software not in accordance with
+* the terms of the Agreement is a violation of copyright law.
+*/
+// 10:12 AM 10/16/2026
+// by Rajib Chy
+
+#include <svc/backend.h>
+#include <iterator>
+
+// systemd's names, in enum order
+static const char* const UNIT_ACTIVE_STATE_NAMES[] = {
+    "inactive", "active", "reloading", "failed", "activating", "deactivating", "maintenance", "refreshing", "unknown"
+};
+
+static const char* const UNIT_SUB_STATE_NAMES[] = {
+    "unknown", "dead", "condition", "start-pre", "start", "start-post", "running", "exited", "reload", "stop",
+    "stop-watchdog", "stop-sigterm", "stop-sigkill", "stop-post", "final-watchdog", "final-sigterm",
+    "final-sigkill", "failed", "auto-restart", "cleaning"
+};
+
+static_assert( std::size( UNIT_ACTIVE_STATE_NAMES ) == static_cast<size_t>( unit_active_state::UNKNOWN ) + 1 );
+static_assert( std::size( UNIT_SUB_STATE_NAMES ) == static_cast<size_t>( unit_sub_state::CLEANING ) + 1 );
+
+unit_active_state _to_unit_active_state( const std::string& value ) {
+
+    if ( value.empty( ) ) return unit_active_state::INACTIVE;
+
+    for ( size_t i = 0; i < std::size( UNIT_ACTIVE_STATE_NAMES ) - 1; i++ ) {
+        if ( value == UNIT_ACTIVE_STATE_NAMES[i] ) {
+            return static_cast<unit_active_state>( i );
+        }
+    }
+
+    return unit_active_state::UNKNOWN;
+}
+
+unit_sub_state _to_unit_sub_state( const std::string& value ) {
+
+    for ( size_t i = 1; i < std::size( UNIT_SUB_STATE_NAMES ); i++ ) {
+        if ( value == UNIT_SUB_STATE_NAMES[i] ) {
+            return static_cast<unit_sub_state>( i );
+        }
+    }
+
+    return unit_sub_state::UNKNOWN;
+}
+
+const char* _unit_active_state_name( unit_active_state state ) {
+    size_t index = static_cast<size_t>( state );
+    return index < std::size( UNIT_ACTIVE_STATE_NAMES ) ? UNIT_ACTIVE_STATE_NAMES[index] : "unknown";
+}
+
+const char* _unit_sub_state_name( unit_sub_state state ) {
+    size_t index = static_cast<size_t>( state );
+    return index < std::size( UNIT_SUB_STATE_NAMES ) ? UNIT_SUB_STATE_NAMES[index] : "unknown";
+}
@@ -22,27 +22,30 @@
 #include <vector>
 #include <stdexcept>
 #include <exception>
+#include <utility> // std::move
 #include <svc/time-range.h>
 #include <svc/json-config.h>
 
 
-#ifdef USE_HTTP_DAY_STATUS
-
 #ifndef MAX_PORT
 #define MAX_PORT 0xFFFF  // Define the maximum port number (65535) if not already defined
 #endif // !MAX_PORT
 
+#ifdef USE_HTTP_DAY_STATUS
+
 void _load_config(
-     std::vector<svc_config*>& svc_configs,
+     service_table_t& services,
      std::vector<dust_clean_config*>& dust_configs,
+     handler_config& handler_cfg,
      std::string& http_server, std::string& http_port 
 ) {
 
 #else
 
 void _load_config(
-     std::vector<svc_config*>& svc_configs,
-     std::vector<dust_clean_config*>& dust_configs
+     service_table_t& services,
+     std::vector<dust_clean_config*>& dust_configs,
+     handler_config& handler_cfg
 ) {
 
 #endif //!USE_HTTP_DAY_STATUS
@@ -52,6 +55,16 @@ void _load_config(
 
     json_config_t part;
 
+    // Read the optional parallelism of dependency cascades
+    if( reader.get_int( "max_parallel", &handler_cfg.max_parallel ) != 0 && handler_cfg.max_parallel < 1 ) {
+        throw std::runtime_error( "config->max_parallel (number) must be greater than 0 at ./svcm/config.json" );
+    }
+
+    // Read the optional size of the action worker pool
+    if( reader.get_int( "workers", &handler_cfg.workers ) != 0 && handler_cfg.workers < 1 ) {
+        throw std::runtime_error( "config->workers (number) must be greater than 0 at ./svcm/config.json" );
+    }
+
 #ifdef USE_HTTP_DAY_STATUS
 
     // Read HTTP configuration
@@ -82,50 +95,87 @@ void _load_config(
 
 #endif //!USE_HTTP_DAY_STATUS
 
+    // Read the optional metrics listener, served on the loopback interface only
+    if( reader.get_next_part( "metrics", part ) != 0 ) {
+
+        if( part.get_int( "port", &handler_cfg.metrics_port ) == 0 ) {
+            throw std::runtime_error( "config->metrics->port (number) not found at ./svcm/config.json" );
+        }
+
+        part.clear( );
+
+        if ( handler_cfg.metrics_port <= 0 || handler_cfg.metrics_port >= MAX_PORT ) {
+            throw std::runtime_error( "config->metrics->port (number) invalid. Port range must be < 65535; File: ./svcm/config.json" );
+        }
+    }
+
+    // Read the optional restart backoff; every field keeps its default when missing
+    if( reader.get_next_part( "backoff", part ) != 0 ) {
+
+        backoff_config& backoff = handler_cfg.backoff;
+
+        part.get_int( "threshold", &backoff.threshold );
+        part.get_int( "window", &backoff.window );
+        part.get_int( "initial", &backoff.initial );
+        part.get_int( "max", &backoff.max );
+
+        part.clear( );
+
+        if ( backoff.threshold < 1 || backoff.window < 1 || backoff.initial < 1 || backoff.max < backoff.initial ) {
+            throw std::runtime_error( "config->backoff invalid. threshold, window and initial must be greater than 0 and max at least initial; File: ./svcm/config.json" );
+        }
+    }
+
     // Read service configurations (array of services)
     if( reader.get_next_part( "svc", part, 1 ) == 0 ) {
         throw std::runtime_error( "config->svc (Array) config not found at ./svcm/config.json" );
     }
 
+    services.clear( );
+
     // Iterate over each service configuration in the array
     part.each( [&]( json_config_t& next_part ) {
-        svc_config* fcfg = new svc_config;  // Allocate new service configuration object
+        svc_config fcfg;
+        std::string start_time; // "08:30:15";
+        std::string end_time; // "23:10:15";
+        std::string restart_time;
+        bool required_workday = false;
 
         // Extract service name
-        if( next_part.get_string( "name", fcfg->service_name ) == 0 ) {
+        if( next_part.get_string( "name", fcfg.service_name ) == 0 ) {
             throw std::runtime_error( "config->svc->[index]->name (string) not found at ./svcm/config.json" );
         }
 
         // Extract start time
-        if( next_part.get_string( "start", fcfg->start_time ) == 0 ) {
+        if( next_part.get_string( "start", start_time ) == 0 ) {
             throw std::runtime_error( "config->svc->[index]->start (string) time not found at ./svcm/config.json" );
         }
 
         // Extract end time
-        if( next_part.get_string("end", fcfg->end_time) == 0 ) {
+        if( next_part.get_string( "end", end_time ) == 0 ) {
             throw std::runtime_error( "config->svc->[index]->end (string) time not found at ./svcm/config.json" );
         }
 
-        if( next_part.get_string( "restart", fcfg->restart_time ) == 0 ) {
+        if( next_part.get_string( "restart", restart_time ) == 0 ) {
             // this service not supported restart
         }
 
         // Extract required_workday flag (boolean)
-        if( next_part.get_bool( "required_workday", &fcfg->required_workday ) == 0) {
+        if( next_part.get_bool( "required_workday", &required_workday ) == 0) {
             throw std::runtime_error( "config->svc->[index]->required_workday (boolean) not found at ./svcm/config.json" );
         }
 
         // Extract dependent service
-        if( next_part.get_to( "dependent", &fcfg->dependent ) > 0) {
-            fcfg->has_dependent_service = fcfg->dependent.size() > 0;
-        }
+        next_part.get_to( "dependent", &fcfg.dependent );
         
         // Create a time range object using start and end time
-        fcfg->time_range = new time_range_t( fcfg->start_time, fcfg->end_time, fcfg->restart_time );
+        svc_schedule schedule( time_range_t( start_time, end_time, restart_time ) );
 
-        fcfg->is_restart_support = fcfg->time_range->is_restart_supported( );
+        schedule.required_workday = required_workday;
+        schedule.has_dependent_service = fcfg.dependent.size() > 0;
+        schedule.is_restart_support = schedule.time_range.is_restart_supported( );
         
-        svc_configs.push_back( fcfg );  // Store the service configuration
+        services.add( std::move( fcfg ), std::move( schedule ) );  // Store the service configuration
 
     });
 
@@ -151,4 +201,45 @@ void _load_config(
     }
 
     reader.clear( );  // Clear the JSON reader to free resources
-}
\ No newline at end of file
+}
+
+size_t service_table_t::add( svc_config&& config, svc_schedule&& schedule ) {
+    _configs.push_back( std::move( config ) );
+    _schedules.push_back( std::move( schedule ) );
+    return _schedules.size( ) - 1;
+}
+
+void service_table_t::reserve( size_t count ) {
+    _configs.reserve( count );
+    _schedules.reserve( count );
+}
+
+void service_table_t::clear( ) {
+    // Swapping with empty tables releases the storage, not just the elements
+    std::vector<svc_config>( ).swap( _configs );
+    std::vector<svc_schedule>( ).swap( _schedules );
+}
+
+size_t service_table_t::size( ) const {
+    return _schedules.size( );
+}
+
+bool service_table_t::empty( ) const {
+    return _schedules.empty( );
+}
+
+svc_schedule& service_table_t::get_schedule( size_t index ) {
+    return _schedules[index];
+}
+
+const svc_schedule& service_table_t::get_schedule( size_t index ) const {
+    return _schedules[index];
+}
+
+svc_config& service_table_t::get_config( size_t index ) {
+    return _configs[index];
+}
+
+const svc_config& service_table_t::get_config( size_t index ) const {
+    return _configs[index];
+}
@@ -0,0 +1,290 @@
+/*
+* Copyright FSys Tech Limited [FSys]. All rights reserved.
+*
+* This software owned by FSys Tech Limited [FSys] and is protected by copyright law
+* and international copyright treaties.
+*
+* Access to and use of the software is governed by the terms of the applicable FSys Software
+* Services Agreement (the Agreement) and Customer end user license agreements granting
+* a non-assignable, non-transferable and non-exclusive license to use the software
+* for it's own data processing purposes under the terms defined in the Agreement.
+*
+* Except as otherwise granted within the terms of the Agreement, copying or reproduction of any part
+* of this source code or associated reference material to any other location for further reproduction
+* or redistribution, and any amendments to this copyright notice, are expressly prohibited.
+*
+* Any reproduction or redistribution for sale or hiring of the Software not in accordance with
+* the terms of the Agreement is a violation of copyright law.
+*/
+// 9:20 AM 10/17/2026
+// by Rajib Chy
+
+#include <svc/control.h>
+#include <cerrno>
+#include <cstring>
+#include <sstream>
+#include <unistd.h>
+#include <sys/un.h>
+#include <sys/stat.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+
+// A client sending a longer line is disconnected
+constexpr size_t MAX_REQUEST_LENGTH = 4096;
+// A client leaving more response bytes unread is disconnected
+constexpr size_t MAX_RESPONSE_BACKLOG = 1024 * 1024;
+// Further clients are refused until one disconnects
+constexpr size_t MAX_CONNECTIONS = 32;
+
+service_control_t::service_control_t( service_reactor_t& reactor ) : _reactor( reactor ) { }
+
+service_control_t::~service_control_t( ) {
+    close( );
+}
+
+void service_control_t::set_last_error( const char* action ) {
+    _last_error = std::string( action ) + ": " + std::strerror( errno );
+}
+
+const char* service_control_t::get_last_error( ) {
+    return _last_error.c_str( );
+}
+
+int service_control_t::open( const std::string& path, request_handler handler ) {
+
+    sockaddr_un address{ };
+    address.sun_family = AF_UNIX;
+
+    if ( path.size( ) >= sizeof( address.sun_path ) ) {
+        _last_error = "Socket path too long: " + path;
+        return -1;
+    }
+
+    std::memcpy( address.sun_path, path.c_str( ), path.size( ) + 1 );
+
+    _listen_fd = socket( AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0 );
+
+    if ( _listen_fd < 0 ) {
+        set_last_error( "socket" );
+        return -1;
+    }
+
+    // Left behind if the previous run was killed
+    unlink( path.c_str( ) );
+
+    // Only the owner may control the manager
+    mode_t mask = umask( 0077 );
+    int bound = bind( _listen_fd, reinterpret_cast<sockaddr*>( &address ), sizeof( address ) );
+    umask( mask );
+
+    if ( bound < 0 || listen( _listen_fd, 8 ) < 0 ) {
+        set_last_error( bound < 0 ? "bind" : "listen" );
+        ::close( _listen_fd );
+        _listen_fd = -1;
+        return -1;
+    }
+
+    if ( _reactor.add( _listen_fd, EPOLLIN, [this]( uint32_t /*events*/ ) { accept_connections( ); } ) < 0 ) {
+        _last_error = _reactor.get_last_error( );
+        ::close( _listen_fd );
+        _listen_fd = -1;
+        unlink( path.c_str( ) );
+        return -1;
+    }
+
+    _path = path;
+    _handler = std::move( handler );
+
+    return 1;
+}
+
+void service_control_t::close( ) {
+
+    while ( !_connections.empty( ) ) {
+        drop( _connections.begin( )->first );
+    }
+
+    if ( _listen_fd >= 0 ) {
+        _reactor.remove( _listen_fd );
+        ::close( _listen_fd );
+        _listen_fd = -1;
+        unlink( _path.c_str( ) );
+    }
+}
+
+void service_control_t::accept_connections( ) {
+
+    while ( true ) {
+
+        int fd = accept4( _listen_fd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC );
+
+        if ( fd < 0 ) return;
+
+        if ( _connections.size( ) >= MAX_CONNECTIONS ) {
+            ::close( fd );
+            continue;
+        }
+
+        if ( _reactor.add( fd, EPOLLIN, [this, fd]( uint32_t events ) {
+
+            if ( events & EPOLLERR ) {
+                drop( fd );
+                return;
+            }
+
+            if ( events & EPOLLOUT ) {
+                flush( fd );
+            }
+
+            // A hang-up is read to its end, the requests sent before it still run
+            if ( events & ( EPOLLIN | EPOLLHUP ) ) {
+                on_readable( fd );
+            }
+
+        }) < 0 ) {
+            ::close( fd );
+            continue;
+        }
+
+        _connections[fd];
+    }
+}
+
+void service_control_t::on_readable( int fd ) {
+
+    auto it = _connections.find( fd );
+
+    if ( it == _connections.end( ) ) return;
+
+    connection& client = it->second;
+    char buffer[1024];
+
+    while ( !client.closing ) {
+
+        ssize_t length = read( fd, buffer, sizeof( buffer ) );
+
+        if ( length == 0 ) {
+            // Shut down after sending (e.g. socat, nc -N); answered before it is dropped
+            client.closing = true;
+            break;
+        }
+
+        if ( length < 0 ) {
+
+            if ( errno == EAGAIN || errno == EWOULDBLOCK ) break;
+
+            drop( fd );
+            return;
+        }
+
+        client.input.append( buffer, static_cast<size_t>( length ) );
+    }
+
+    std::string& input = client.input;
+    size_t start = 0;
+    size_t end;
+
+    while ( ( end = input.find( '\n', start ) ) != std::string::npos ) {
+        execute( input.substr( start, end - start ), client.output );
+        start = end + 1;
+    }
+
+    input.erase( 0, start );
+
+    if ( input.size( ) > MAX_REQUEST_LENGTH ) {
+        drop( fd );
+        return;
+    }
+
+    // No newline follows the last request of a closing client
+    if ( client.closing && !input.empty( ) ) {
+        execute( input, client.output );
+        input.clear( );
+    }
+
+    flush( fd );
+
+    it = _connections.find( fd );
+
+    // Sends requests but does not read the responses
+    if ( it != _connections.end( ) && it->second.output.size( ) > MAX_RESPONSE_BACKLOG ) {
+        drop( fd );
+    }
+}
+
+void service_control_t::flush( int fd ) {
+
+    auto it = _connections.find( fd );
+
+    if ( it == _connections.end( ) ) return;
+
+    std::string& output = it->second.output;
+
+    while ( !output.empty( ) ) {
+
+        ssize_t written = send( fd, output.data( ), output.size( ), MSG_NOSIGNAL );
+
+        if ( written < 0 ) {
+
+            if ( errno == EAGAIN || errno == EWOULDBLOCK ) break;
+
+            drop( fd );
+            return;
+        }
+
+        output.erase( 0, static_cast<size_t>( written ) );
+    }
+
+    if ( it->second.closing ) {
+
+        if ( output.empty( ) ) {
+            drop( fd );
+            return;
+        }
+
+        // Nothing more to read, EPOLLIN would keep reporting the end of input
+        _reactor.modify( fd, EPOLLOUT );
+        return;
+    }
+
+    // Wait for room in the socket buffer only while a response is pending
+    _reactor.modify( fd, output.empty( ) ? EPOLLIN : EPOLLIN | EPOLLOUT );
+}
+
+void service_control_t::drop( int fd ) {
+    _reactor.remove( fd );
+    ::close( fd );
+    _connections.erase( fd );
+}
+
+void service_control_t::execute( const std::string& line, std::string& output ) {
+
+    std::istringstream stream( line );
+    std::string command;
+    std::vector<std::string> args;
+
+    stream >> command;
+
+    for ( std::string arg; stream >> arg; ) {
+        args.push_back( arg );
+    }
+
+    // An empty line is a no-op, handy for checking that the manager is alive
+    if ( command.empty( ) ) {
+        output.append( "OK 0\n" );
+        return;
+    }
+
+    std::vector<std::string> lines;
+
+    if ( _handler( command, args, lines ) == 0 ) {
+        output.append( "ERR " ).append( lines.empty( ) ? "failed" : lines[0] ).append( "\n" );
+        return;
+    }
+
+    output.append( "OK " ).append( std::to_string( lines.size( ) ) ).append( "\n" );
+
+    for ( const auto& response_line : lines ) {
+        output.append( response_line ).append( "\n" );
+    }
+}
@@ -21,6 +21,7 @@
 // by Rajib Chy
 
 #include <svc/dust-cleaner.h>
+#include <svc/metrics.h>
 #include <fstream>
 
 bool dust_cleaner_t::is_deletable( const fs::file_time_type& creation_time ) {
@@ -46,6 +47,10 @@ bool dust_cleaner_t::need_delete( const fs::path& filePath, const std::string& e
 
 constexpr char CACHE_KEY[] = "/cache/";
 
+static metric_counter_t& _files_scanned = _metrics( ).counter( "svcm_dust_files_scanned_total", "Files examined by the dust cleaner." );
+static metric_counter_t& _files_deleted = _metrics( ).counter( "svcm_dust_files_deleted_total", "Files deleted by the dust cleaner." );
+static metric_counter_t& _bytes_freed = _metrics( ).counter( "svcm_dust_bytes_freed_total", "Bytes freed by the dust cleaner." );
+
 void dust_cleaner_t::delete_log_files( 
     std::shared_ptr<svc_logger>& logger, const fs::path& dir, 
     const std::string& ext, bool is_cache 
@@ -62,6 +67,8 @@ void dust_cleaner_t::delete_log_files(
 
         if ( !fs::is_regular_file( path ) ) continue;
 
+        _files_scanned.add( );
+
         if ( is_cache ) {
 
             const std::string& path_str = path.string();
@@ -79,7 +86,13 @@ void dust_cleaner_t::delete_log_files(
 
         try {
 
-            fs::remove( path );
+            std::error_code size_error;
+            uintmax_t size = fs::file_size( path, size_error );
+
+            if ( fs::remove( path ) ) {
+                _files_deleted.add( );
+                _bytes_freed.add( size_error ? 0 : static_cast<uint64_t>( size ) );
+            }
 
         } catch ( const std::exception& e ) {
 
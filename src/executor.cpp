@@ -0,0 +1,119 @@
+/*
+* Copyright FSys Tech Limited [FSys]. All rights reserved.
+*
+* This software owned by FSys Tech Limited [FSys] and is protected by copyright law
+* and international copyright treaties.
+*
+* Access to and use of the software is governed by the terms of the applicable FSys Software
+* Services Agreement (the Agreement) and Customer end user license agreements granting
+* a non-assignable, non-transferable and non-exclusive license to use the software
+* for it's own data processing purposes under the terms defined in the Agreement.
+*
+* Except as otherwise granted within the terms of the Agreement, copying or reproduction of any part
+* of this source code or associated reference material to any other location for further reproduction
+* or redistribution, and any amendments to this copyright notice, are expressly prohibited.
+*
+* Any reproduction or redistribution for sale or hiring of the Software not in accordance with
+* the terms of the Agreement is a violation of copyright law.
+*/
+// 4:05 PM 10/16/2026
+// by Rajib Chy
+
+#include <svc/executor.h>
+#include <algorithm>
+
+service_executor_t::~service_executor_t( ) {
+    clear( );
+}
+
+void service_executor_t::spawn( service_task task, error_handler on_error ) {
+    _ready.push_back( task._handle );
+    _tasks.push_back( spawned_task{ std::move( task ), std::move( on_error ) } );
+}
+
+service_executor_t::wait_awaiter service_executor_t::wait_until( clock::time_point deadline, std::function<bool( )> condition ) {
+    return wait_awaiter( *this, deadline, std::move( condition ) );
+}
+
+service_executor_t::wait_awaiter service_executor_t::sleep_until( clock::time_point deadline ) {
+    return wait_awaiter( *this, deadline, nullptr );
+}
+
+void service_executor_t::run( ) {
+
+    while ( true ) {
+
+        while ( !_ready.empty( ) ) {
+            std::coroutine_handle<> handle = _ready.front( );
+            _ready.pop_front( );
+            handle.resume( );
+        }
+
+        // Conditions are re-checked here, resumed tasks may have changed them
+        clock::time_point now = clock::now( );
+
+        for ( size_t i = 0; i < _waiters.size( ); ) {
+
+            waiter& next = _waiters[i];
+            bool condition_met = *next.condition && ( *next.condition )( );
+
+            if ( !condition_met && now < next.deadline ) {
+                i++;
+                continue;
+            }
+
+            *next.result = condition_met;
+            _ready.push_back( next.handle );
+
+            _waiters[i] = _waiters.back( );
+            _waiters.pop_back( );
+        }
+
+        if ( _ready.empty( ) ) break;
+    }
+
+    std::vector<std::pair<error_handler, std::exception_ptr>> failed;
+
+    for ( auto it = _tasks.begin( ); it != _tasks.end( ); ) {
+
+        if ( !it->task.is_done( ) ) {
+            ++it;
+            continue;
+        }
+
+        std::exception_ptr exception = it->task._handle.promise( ).exception;
+
+        if ( exception && it->on_error ) {
+            failed.emplace_back( std::move( it->on_error ), exception );
+        }
+
+        it = _tasks.erase( it );
+    }
+
+    // Reported once the task list is consistent again, a handler may spawn
+    for ( auto& [on_error, exception] : failed ) {
+        on_error( exception );
+    }
+}
+
+service_executor_t::clock::time_point service_executor_t::next_deadline( ) const {
+
+    clock::time_point deadline = clock::time_point::max( );
+
+    for ( const auto& next : _waiters ) {
+        deadline = std::min( deadline, next.deadline );
+    }
+
+    return deadline;
+}
+
+size_t service_executor_t::size( ) const {
+    return _tasks.size( );
+}
+
+void service_executor_t::clear( ) {
+    // Destroying a spawned frame destroys the frames of the tasks it awaits
+    _waiters.clear( );
+    _ready.clear( );
+    _tasks.clear( );
+}
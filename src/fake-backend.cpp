@@ -0,0 +1,549 @@
+/*
+* Copyright FSys Tech Limited [FSys]. All rights reserved.
+*
+* This software owned by FSys Tech Limited [FSys] and is protected by copyright law
+* and international copyright treaties.
+*
+* Access to and use of the software is governed by the terms of the applicable FSys Software
+* Services Agreement (the Agreement) and Customer end user license agreements granting
+* a non-assignable, non-transferable and non-exclusive license to use the software
+* for it's own data processing purposes under the terms defined in the Agreement.
+*
+* Except as otherwise granted within the terms of the Agreement, copying or reproduction of any part
+* of this source code or associated reference material to any other location for further reproduction
+* or redistribution, and any amendments to this copyright notice, are expressly prohibited.
+*
+* Any reproduction or redistribution for sale or hiring of the Software not in accordance with
+* the terms of the Agreement is a violation of copyright law.
+*/
+// 10:12 AM 10/16/2026
+// by Rajib Chy
+
+#ifndef USE_PRODUCTION_BUILD
+
+#include <svc/fake-backend.h>
+#include <stdexcept>
+#include <algorithm>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+
+// Exit status of a main process killed by SIGKILL
+constexpr int32_t KILLED_STATUS = 9;
+
+// Wall clock in microseconds, the unit of systemd's timestamps
+static uint64_t _realtime_usec( ) {
+    return static_cast<uint64_t>( std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::system_clock::now( ).time_since_epoch( )
+    ).count( ) );
+}
+
+fake_systemd_t::fake_systemd_t( const fake_backend_config& config ) : _config( config ), _random( config.seed ) {
+    _thread = std::thread( &fake_systemd_t::run, this );
+}
+
+fake_systemd_t::~fake_systemd_t( ) {
+
+    {
+        std::lock_guard<std::mutex> lock( _mutex );
+        _stopping = true;
+    }
+
+    _cv.notify_all( );
+
+    if ( _thread.joinable( ) ) {
+        _thread.join( );
+    }
+}
+
+service_backend_factory fake_systemd_t::factory( ) {
+
+    std::shared_ptr<fake_systemd_t> self = shared_from_this( );
+
+    return [self]( bool external_loop ) -> std::unique_ptr<service_backend_t> {
+        return std::make_unique<fake_backend_t>( self, external_loop );
+    };
+}
+
+uint64_t fake_systemd_t::calls( ) const {
+    return _calls.load( );
+}
+
+void fake_systemd_t::kill( const std::string& service_name ) {
+
+    std::vector<std::pair<std::string, unit_status>> changes;
+
+    {
+        std::lock_guard<std::mutex> lock( _mutex );
+
+        unit_status& status = unit( service_name );
+
+        if ( status.active_state != unit_active_state::ACTIVE ) return;
+
+        status.active_state = unit_active_state::FAILED;
+        status.sub_state = unit_sub_state::FAILED;
+        status.main_pid = 0;
+        status.exec_main_status = KILLED_STATUS;
+
+        changes.emplace_back( service_name, status );
+    }
+
+    notify( changes );
+}
+
+const fake_operation_config& fake_systemd_t::operation_config( unit_operation operation ) const {
+    switch ( operation ) {
+        case unit_operation::STOP: return _config.stop;
+        case unit_operation::RESTART: return _config.restart;
+        case unit_operation::START:
+        default: return _config.start;
+    }
+}
+
+void fake_systemd_t::simulate_call( const fake_operation_config& config ) {
+    if ( config.latency.count( ) > 0 ) {
+        std::this_thread::sleep_for( config.latency );
+    }
+}
+
+bool fake_systemd_t::draw_failure( double rate ) {
+    // Caller holds _mutex
+    return rate > 0.0 && std::uniform_real_distribution<double>( 0.0, 1.0 )( _random ) < rate;
+}
+
+unit_status& fake_systemd_t::unit( const std::string& service_name ) {
+    // Caller holds _mutex; unknown units come into existence inactive
+    auto it = _units.find( service_name );
+
+    if ( it == _units.end( ) ) {
+        unit_status status;
+        status.sub_state = unit_sub_state::DEAD;
+        it = _units.emplace( service_name, status ).first;
+    }
+
+    return it->second;
+}
+
+int fake_systemd_t::queue_job( unit_operation operation, const std::string& service_name, std::shared_ptr<service_job_t>& job, std::string& error ) {
+
+    _calls++;
+
+    std::vector<std::pair<std::string, unit_status>> changes;
+
+    {
+        std::lock_guard<std::mutex> lock( _mutex );
+
+        if ( draw_failure( operation_config( operation ).failure_rate ) ) {
+            error = "Fake error: call failed";
+            return -1;
+        }
+
+        job = std::make_shared<service_job_t>( "/org/freedesktop/systemd1/job/" + std::to_string( _next_job++ ) );
+
+        unit_status& status = unit( service_name );
+
+        // The job runs from now on, like systemd's transition into the transient states
+        if ( operation == unit_operation::STOP ) {
+            if ( status.active_state == unit_active_state::ACTIVE ) {
+                status.active_state = unit_active_state::DEACTIVATING;
+                status.sub_state = unit_sub_state::STOP_SIGTERM;
+                changes.emplace_back( service_name, status );
+            }
+        } else if ( status.active_state != unit_active_state::ACTIVE || operation == unit_operation::RESTART ) {
+            status.active_state = unit_active_state::ACTIVATING;
+            status.sub_state = unit_sub_state::START;
+            status.inactive_exit_timestamp = _realtime_usec( );
+            changes.emplace_back( service_name, status );
+        }
+
+        _jobs.emplace( std::chrono::steady_clock::now( ) + _config.job_duration, fake_job{ service_name, operation, job } );
+    }
+
+    _cv.notify_all( );
+
+    notify( changes );
+
+    return 1;
+}
+
+int fake_systemd_t::read_status( const std::string& service_name, unit_status& status, std::string& error ) {
+
+    std::lock_guard<std::mutex> lock( _mutex );
+
+    if ( draw_failure( _config.status.failure_rate ) ) {
+        status = unit_status( );
+        error = "Fake error: status read failed";
+        return -1;
+    }
+
+    status = unit( service_name );
+
+    return 1;
+}
+
+int fake_systemd_t::reset_failed( const std::string& service_name, std::string& error ) {
+
+    std::vector<std::pair<std::string, unit_status>> changes;
+
+    {
+        std::lock_guard<std::mutex> lock( _mutex );
+
+        if ( draw_failure( _config.status.failure_rate ) ) {
+            error = "Fake error: reset failed";
+            return -1;
+        }
+
+        unit_status& status = unit( service_name );
+
+        if ( status.active_state != unit_active_state::FAILED ) return 1;
+
+        status.active_state = unit_active_state::INACTIVE;
+        status.sub_state = unit_sub_state::DEAD;
+        changes.emplace_back( service_name, status );
+    }
+
+    notify( changes );
+
+    return 1;
+}
+
+void fake_systemd_t::attach( fake_backend_t* connection ) {
+    std::lock_guard<std::recursive_mutex> lock( _connection_mutex );
+    _connections.push_back( connection );
+}
+
+void fake_systemd_t::detach( fake_backend_t* connection ) {
+    std::lock_guard<std::recursive_mutex> lock( _connection_mutex );
+    _connections.erase( std::remove( _connections.begin( ), _connections.end( ), connection ), _connections.end( ) );
+}
+
+void fake_systemd_t::notify( const std::vector<std::pair<std::string, unit_status>>& changes ) {
+
+    if ( changes.empty( ) ) return;
+
+    // Held throughout, so a connection is not destroyed while it is notified;
+    // recursive, a listener may call back into this instance
+    std::lock_guard<std::recursive_mutex> lock( _connection_mutex );
+
+    for ( fake_backend_t* connection : _connections ) {
+        for ( const auto& change : changes ) {
+            connection->on_unit_changed( change.first, change.second );
+        }
+    }
+}
+
+void fake_systemd_t::run( ) {
+
+    std::vector<std::pair<std::string, unit_status>> changes;
+    std::vector<std::pair<std::shared_ptr<service_job_t>, job_result>> finished;
+
+    while ( true ) {
+
+        changes.clear( );
+        finished.clear( );
+
+        {
+            std::unique_lock<std::mutex> lock( _mutex );
+
+            // Woken for an earlier job as well; nothing may be due yet then
+            if ( _jobs.empty( ) ) {
+                _cv.wait( lock, [this]( ) { return _stopping || !_jobs.empty( ); } );
+            } else {
+                _cv.wait_until( lock, _jobs.begin( )->first );
+            }
+
+            if ( _stopping ) return;
+
+            const auto now = std::chrono::steady_clock::now( );
+
+            while ( !_jobs.empty( ) && _jobs.begin( )->first <= now ) {
+
+                fake_job entry = std::move( _jobs.begin( )->second );
+                _jobs.erase( _jobs.begin( ) );
+
+                unit_status& status = unit( entry.service_name );
+                job_result result = job_result::DONE;
+
+                if ( entry.operation == unit_operation::STOP ) {
+
+                    if ( status.active_state == unit_active_state::INACTIVE ) {
+                        finished.emplace_back( entry.job, result );
+                        continue;
+                    }
+
+                    status.active_state = unit_active_state::INACTIVE;
+                    status.sub_state = unit_sub_state::DEAD;
+                    status.main_pid = 0;
+                    status.exec_main_status = 0;
+
+                } else {
+
+                    if ( status.active_state == unit_active_state::ACTIVE ) {
+                        finished.emplace_back( entry.job, result );
+                        continue;
+                    }
+
+                    if ( draw_failure( _config.job_failure_rate ) ) {
+                        status.active_state = unit_active_state::FAILED;
+                        status.sub_state = unit_sub_state::FAILED;
+                        status.main_pid = 0;
+                        status.exec_main_status = 1;
+                        result = job_result::FAILED;
+                    } else {
+                        status.active_state = unit_active_state::ACTIVE;
+                        status.sub_state = unit_sub_state::RUNNING;
+                        status.main_pid = _next_pid++;
+                        status.exec_main_status = 0;
+                        status.active_enter_timestamp = _realtime_usec( );
+                    }
+                }
+
+                changes.emplace_back( entry.service_name, status );
+                finished.emplace_back( entry.job, result );
+            }
+        }
+
+        // Like systemd: the properties change before the job is removed
+        notify( changes );
+
+        for ( auto& entry : finished ) {
+            entry.first->complete( entry.second );
+        }
+    }
+}
+
+fake_backend_t::fake_backend_t( std::shared_ptr<fake_systemd_t> systemd, bool external_loop )
+    : _systemd( std::move( systemd ) ), _external_loop( external_loop ) {
+
+    _event_fd = eventfd( 0, EFD_NONBLOCK | EFD_CLOEXEC );
+
+    if ( _event_fd < 0 ) {
+        throw std::runtime_error( "Unable to create the fake backend's event descriptor" );
+    }
+
+    _systemd->attach( this );
+}
+
+fake_backend_t::~fake_backend_t( ) {
+
+    _systemd->detach( this );
+
+    if ( _event_fd >= 0 ) {
+        ::close( _event_fd );
+    }
+}
+
+backend_poll_data fake_backend_t::get_poll_data( ) const {
+
+    backend_poll_data result;
+    result.fd = _event_fd;
+    result.events = POLLIN;
+
+    return result;
+}
+
+int fake_backend_t::process_pending( ) {
+
+    uint64_t value;
+    while ( ::read( _event_fd, &value, sizeof( value ) ) > 0 ) { }
+
+    std::deque<std::pair<std::string, unit_status>> pending;
+
+    {
+        std::lock_guard<std::mutex> lock( _mutex );
+        pending.swap( _pending );
+    }
+
+    for ( const auto& change : pending ) {
+        update_cache( change.first, change.second );
+    }
+
+    return static_cast<int>( pending.size( ) );
+}
+
+void fake_backend_t::on_unit_changed( const std::string& service_name, const unit_status& status ) {
+
+    if ( !_external_loop ) {
+        update_cache( service_name, status );
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock( _mutex );
+
+        if ( _watched.find( service_name ) == _watched.end( ) ) return;
+
+        _pending.emplace_back( service_name, status );
+    }
+
+    uint64_t one = 1;
+    ::write( _event_fd, &one, sizeof( one ) );
+}
+
+void fake_backend_t::update_cache( const std::string& service_name, const unit_status& status ) {
+
+    state_listener listener;
+
+    {
+        std::lock_guard<std::mutex> lock( _mutex );
+
+        auto it = _watched.find( service_name );
+
+        if ( it == _watched.end( ) ) return;
+
+        unit_active_state previous = it->second.active_state;
+        it->second = status;
+
+        if ( previous == status.active_state ) return;
+
+        listener = _listener;
+    }
+
+    // Notify outside the lock, the listener may query the cache again
+    if ( listener ) {
+        listener( service_name, status.active_state );
+    }
+}
+
+int fake_backend_t::call( unit_operation operation, const std::string& service_name, std::shared_ptr<service_job_t>& job ) {
+    _systemd->simulate_call( _systemd->operation_config( operation ) );
+    return _systemd->queue_job( operation, service_name, job, _last_error );
+}
+
+int fake_backend_t::start( const std::string& service_name, std::shared_ptr<service_job_t>& job ) {
+    return call( unit_operation::START, service_name, job );
+}
+
+int fake_backend_t::stop( const std::string& service_name, std::shared_ptr<service_job_t>& job ) {
+    return call( unit_operation::STOP, service_name, job );
+}
+
+int fake_backend_t::restart( const std::string& service_name, std::shared_ptr<service_job_t>& job ) {
+    return call( unit_operation::RESTART, service_name, job );
+}
+
+int fake_backend_t::reset_failed( const std::string& service_name ) {
+    _systemd->simulate_call( _systemd->_config.status );
+    _systemd->_calls++;
+    return _systemd->reset_failed( service_name, _last_error );
+}
+
+int fake_backend_t::call_many( std::vector<unit_request>& requests ) {
+
+    // Pipelined, so the batch pays the slowest round-trip once
+    fake_operation_config slowest;
+
+    for ( const auto& request : requests ) {
+        slowest.latency = std::max( slowest.latency, _systemd->operation_config( request.operation ).latency );
+    }
+
+    _systemd->simulate_call( slowest );
+
+    int status = 1;
+
+    for ( auto& request : requests ) {
+        if ( request.reset_failed ) {
+            _systemd->_calls++;
+            _systemd->reset_failed( request.service_name, _last_error );
+        }
+        request.status = _systemd->queue_job( request.operation, request.service_name, request.job, _last_error );
+        if ( request.status < 0 ) {
+            request.error = _last_error;
+            status = -1;
+        }
+    }
+
+    return status;
+}
+
+int fake_backend_t::get_status( const std::string& service_name, unit_status& status ) {
+
+    _systemd->simulate_call( _systemd->_config.status );
+    _systemd->_calls++;
+
+    if ( _systemd->read_status( service_name, status, _last_error ) < 0 ) {
+        return -1;
+    }
+
+    // Keep the cache consistent, like the D-Bus backend
+    update_cache( service_name, status );
+
+    return 1;
+}
+
+int fake_backend_t::get_status_many( const std::vector<std::string>& service_names, std::vector<unit_status>& results ) {
+
+    results.assign( service_names.size( ), unit_status( ) );
+
+    if ( service_names.empty( ) ) return 1;
+
+    // One round-trip for all names
+    _systemd->simulate_call( _systemd->_config.status );
+    _systemd->_calls++;
+
+    for ( size_t i = 0; i < service_names.size( ); i++ ) {
+
+        unit_status status;
+
+        if ( _systemd->read_status( service_names[i], status, _last_error ) < 0 ) {
+            return -1;
+        }
+
+        // The bulk call only reports the states
+        results[i].active_state = status.active_state;
+        results[i].sub_state = status.sub_state;
+
+        update_cache( service_names[i], status );
+    }
+
+    return 1;
+}
+
+int fake_backend_t::watch( const std::string& service_name ) {
+
+    _systemd->simulate_call( _systemd->_config.status );
+    _systemd->_calls++;
+
+    unit_status status;
+
+    if ( _systemd->read_status( service_name, status, _last_error ) < 0 ) {
+        return -1;
+    }
+
+    std::lock_guard<std::mutex> lock( _mutex );
+    _watched[service_name] = status;
+
+    return 1;
+}
+
+int fake_backend_t::unwatch( const std::string& service_name ) {
+    std::lock_guard<std::mutex> lock( _mutex );
+    return _watched.erase( service_name ) > 0 ? 1 : 0;
+}
+
+int fake_backend_t::get_cached_status( const std::string& service_name, unit_status& status ) {
+
+    std::lock_guard<std::mutex> lock( _mutex );
+
+    auto it = _watched.find( service_name );
+
+    if ( it == _watched.end( ) ) return 0;
+
+    status = it->second;
+
+    return 1;
+}
+
+void fake_backend_t::set_state_listener( state_listener listener ) {
+    std::lock_guard<std::mutex> lock( _mutex );
+    _listener = std::move( listener );
+}
+
+const char* fake_backend_t::get_last_error( ) {
+    if ( _last_error.empty( ) ) {
+        return nullptr;
+    }
+    return _last_error.c_str( );
+}
+
+#endif // !USE_PRODUCTION_BUILD
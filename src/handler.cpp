@@ -28,8 +28,18 @@
 #include <algorithm> // std::find, std::transform
 #include <thread>  // Required for std::this_thread::sleep_for
 #include <chrono>  // Required for std::chrono::seconds
+#include <csignal>
+#include <pthread.h>
+#include <sys/epoll.h>
 
-service_handler_t::service_handler_t( ) {
+// How long a worker awaits the jobs of a batch before it takes the next; systemd enforces the unit's own timeouts
+constexpr long JOB_WAIT_MS = 120000;
+
+service_handler_t::service_handler_t( ) : service_handler_t( _create_system_backend ) {
+}
+
+service_handler_t::service_handler_t( service_backend_factory backend_factory )
+    : _backend_factory( std::move( backend_factory ) ), _control( _reactor ), _metrics_server( _reactor ), _pipeline( [this]( ) { _reactor.wake( ); } ) {
     
     _logger = std::make_shared<svc_logger>();
 
@@ -37,19 +47,331 @@ service_handler_t::service_handler_t( ) {
         throw std::runtime_error("Unable to open logger");
     }
 
-    _promise = std::make_shared<std::promise<void>>( );
-    _future = _promise->get_future( );
-
 #ifndef USE_HTTP_DAY_STATUS
     _is_working_day = true;
 #endif //!USE_HTTP_DAY_STATUS
 
 }
 
+// Local control socket, next to the configuration
+constexpr char CONTROL_SOCKET_PATH[] = "./svcm/svcm.sock";
+
+// Runtime state kept across restarts of the manager
+constexpr char STATE_SNAPSHOT_PATH[] = "./svcm/state.dat";
+
+// Signals handled on the monitor loop through a signalfd
+static const std::vector<int> HANDLER_SIGNALS = { SIGINT, SIGTERM, SIGHUP, SIGUSR1 };
+
+int _block_handler_signals( ) {
+
+    sigset_t mask;
+    sigemptyset( &mask );
+
+    for ( int signal : HANDLER_SIGNALS ) {
+        sigaddset( &mask, signal );
+    }
+
+    // Threads created afterwards inherit the mask
+    return pthread_sigmask( SIG_BLOCK, &mask, nullptr ) == 0 ? 1 : -1;
+}
+
 int service_handler_t::wait_for( long ms ) {
-    // Wait for the specified time in secoands
-    std::chrono::seconds wait_interval = std::chrono::seconds( ms / 1000 );
-    return _future.wait_for( wait_interval ) == std::future_status::timeout ? 1 : 0;
+
+    // Millisecond precise, on the monotonic clock; events keep being dispatched meanwhile
+    auto deadline = service_reactor_t::clock::now( ) + std::chrono::milliseconds( ms );
+
+    while ( service_reactor_t::clock::now( ) < deadline ) {
+        if ( wait_for_event( deadline ) == 0 ) {
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+int service_handler_t::wait_for_event( service_reactor_t::clock::time_point deadline ) {
+
+    if ( _svc_manager != nullptr ) {
+
+        // sd-bus tells which events and which timeout it is waiting for
+        backend_poll_data poll_data = _svc_manager->get_poll_data( );
+
+        _reactor.modify( poll_data.fd, _to_epoll_events( poll_data.events ) );
+
+        if ( poll_data.timeout >= 0 ) {
+            deadline = std::min( deadline, service_reactor_t::clock::now( ) + std::chrono::milliseconds( poll_data.timeout ) );
+        }
+    }
+
+    int result = _reactor.poll( deadline );
+
+    // Also covers a passed sd-bus timeout
+    if ( _svc_manager != nullptr ) {
+        _svc_manager->process_pending( );
+    }
+
+    return result;
+}
+
+void service_handler_t::on_signal( int signal ) {
+
+    switch ( signal ) {
+
+        case SIGHUP:
+            _logger->info( "Reload requested (SIGHUP)" );
+            _reload_requested = true;
+            break;
+
+        case SIGUSR1:
+            _logger->info( "Status requested (SIGUSR1); Cascades in flight: ", _executor.size( ) );
+
+            sync_service_state( );
+
+            for ( size_t i = 0; i < _services.size( ); i++ ) {
+
+                const svc_schedule& schedule = _services.get_schedule( i );
+
+                _logger->info(
+                    "\"", _services.get_config( i ).service_name, "\" Service status : ",
+                    schedule.state == service_state::ACTIVE ? "Active" : ( schedule.state == service_state::FAILED_BACKOFF ? "Backoff" : "Inactive" ),
+                    "; Pending actions: ", schedule.pending_actions,
+                    "; Failed starts: ", schedule.start_failures
+                );
+            }
+
+            break;
+
+        default:
+            _logger->info( "Exit signal received; System Id: ", signal );
+            _logger->flush( );
+            exit( );
+            break;
+    }
+}
+
+void service_handler_t::get_next_boundary( size_t index, const std::time_t& now_time, std::time_t& epoch, const char*& event ) const {
+
+    const time_range_t& time_range = _services.get_schedule( index ).time_range;
+
+    epoch = 0;
+    event = "-";
+
+    // Same boundaries as `rebuild_schedule`
+    auto consider = [&]( std::time_t boundary, const char* name ) {
+        if ( boundary > now_time && ( epoch == 0 || boundary < epoch ) ) {
+            epoch = boundary;
+            event = name;
+        }
+    };
+
+    consider( time_range.get_start_epoch( ), "start" );
+
+    if ( time_range.get_end_epoch( ) > 0 ) {
+        consider( time_range.get_end_epoch( ) + 1, "end" );
+    }
+
+    consider( time_range.get_restart_epoch( ), "restart" );
+
+    consider( _services.get_schedule( index ).retry_epoch, "retry" );
+}
+
+int service_handler_t::on_control_request( const std::string& command, const std::vector<std::string>& args, std::vector<std::string>& lines ) {
+
+    if ( command == "list" ) {
+
+        std::time_t now_time = std::chrono::system_clock::to_time_t( std::chrono::system_clock::now( ) );
+
+        for ( size_t i = 0; i < _services.size( ); i++ ) {
+
+            const svc_config& service = _services.get_config( i );
+            const svc_schedule& schedule = _services.get_schedule( i );
+
+            // Watched units report systemd's own state, others the last one the manager set
+            std::string state;
+            unit_status status;
+
+            if ( schedule.state == service_state::FAILED_BACKOFF ) {
+                state = "backoff";
+            } else if ( _svc_manager->get_cached_status( service.service_name, status ) == 1 ) {
+                state = _unit_active_state_name( status.active_state );
+            } else {
+                state = schedule.state == service_state::ACTIVE ? "active" : "inactive";
+            }
+
+            std::time_t epoch;
+            const char* event;
+            get_next_boundary( i, now_time, epoch, event );
+
+            lines.push_back(
+                service.service_name + " " + state + " " + std::to_string( epoch ) + " " + event + " " +
+                std::to_string( schedule.pending_actions ) + " " + std::to_string( schedule.cascades )
+            );
+        }
+
+        return 1;
+    }
+
+    if ( command == "stats" ) {
+        // Since the last day switch, in microseconds
+        lines.push_back( "tick_lag " + _tick_lag.summary( ) );
+        lines.push_back( "tick_duration " + _tick_duration.summary( ) );
+        // Since the start
+        lines.push_back(
+            "status_queries " + std::to_string( _status_query_total ) + " " +
+            std::to_string( _status_memo_hits ) + " " + std::to_string( _status_max_queries )
+        );
+        return 1;
+    }
+
+    if ( command == "start" || command == "stop" || command == "restart" ) {
+
+        if ( args.size( ) != 1 ) {
+            lines.push_back( "usage: " + command + " <service>" );
+            return 0;
+        }
+
+        std::string service_name = args[0];
+        _normalized_service_name( service_name );
+
+        size_t index = _registry.find( service_name );
+
+        if ( index == service_registry_t::npos ) {
+            lines.push_back( "unknown service " + service_name );
+            return 0;
+        }
+
+        if ( _services.get_schedule( index ).cascades > 0 ) {
+            lines.push_back( service_name + " is part of a running restart cascade" );
+            return 0;
+        }
+
+        _logger->info( "Control request: ", command, " \"", service_name, "\"" );
+
+        // An operator's request overrides the backoff
+        if ( command != "stop" ) {
+            clear_backoff( index );
+        }
+
+        if ( command == "start" ) {
+            start_service( index );
+        } else if ( command == "stop" ) {
+            stop_service( index );
+        } else if ( _services.get_schedule( index ).has_dependent_service ) {
+            spawn_cascade( index, std::chrono::system_clock::to_time_t( std::chrono::system_clock::now( ) ) );
+        } else {
+            restart_service( index );
+        }
+
+        lines.push_back( command + " " + service_name + " queued" );
+        return 1;
+    }
+
+    if ( command == "clean" ) {
+
+        if ( _cleaner->is_empty( ) ) {
+            lines.push_back( "no dust rules configured" );
+            return 0;
+        }
+
+        _logger->info( "Control request: clean" );
+
+        if ( _pipeline.start( { { "dust-clean", [this]( ) { _cleaner->clean( _logger ); return 1; } } }, nullptr ) == 0 ) {
+            lines.push_back( "day switch or clean in progress" );
+            return 0;
+        }
+
+        lines.push_back( "clean queued" );
+        return 1;
+    }
+
+    if ( command == "reload" ) {
+        _logger->info( "Control request: reload" );
+        _reload_requested = true;
+        lines.push_back( "reload queued" );
+        return 1;
+    }
+
+    lines.push_back( "unknown command " + command + "; expected list, start, stop, restart, clean or reload" );
+    return 0;
+}
+
+int service_handler_t::attach_event_sources( ) {
+
+    backend_poll_data poll_data = _svc_manager->get_poll_data( );
+
+    auto dispatch = [this]( uint32_t /*events*/ ) {
+        _svc_manager->process_pending( );
+    };
+
+    if ( _reactor.add( poll_data.fd, _to_epoll_events( poll_data.events ), dispatch ) < 0 ) {
+        _logger->error( "Unable to poll the D-Bus connection" );
+        _logger->error( _reactor.get_last_error( ) );
+        return 0;
+    }
+
+    // Messages queued by other threads are announced through this descriptor
+    if ( poll_data.event_fd >= 0 && _reactor.add( poll_data.event_fd, EPOLLIN, dispatch ) < 0 ) {
+        _logger->error( "Unable to poll the D-Bus connection" );
+        _logger->error( _reactor.get_last_error( ) );
+        return 0;
+    }
+
+    if ( _reactor.add_signals( HANDLER_SIGNALS, [this]( int signal ) { on_signal( signal ); } ) < 0 ) {
+        _logger->error( "Unable to receive signals" );
+        _logger->error( _reactor.get_last_error( ) );
+        return 0;
+    }
+
+    // Not critical, the configuration is read at startup either way
+    if ( _reactor.add_directory_watch( "./svcm", [this]( const std::string& name ) {
+        if ( name == "config.json" ) {
+            _logger->info( "Configuration file \"./svcm/config.json\" changed; reload requested" );
+            _reload_requested = true;
+        }
+    }) < 0 ) {
+        _logger->error( "Unable to watch \"./svcm\" for configuration changes" );
+        _logger->error( _reactor.get_last_error( ) );
+    }
+
+    return 1;
+}
+
+/**
+ * @brief Normalizes the names of all services and their dependents.
+ */
+static void _normalize_service_names( service_table_t& services ) {
+
+    // Iterate through all services in the table
+    for ( size_t i = 0; i < services.size( ); i++ ) {
+
+        svc_config& service = services.get_config( i );
+
+        // Normalize the primary service name by ensuring it has the correct extension
+        _normalized_service_name( service.service_name );
+
+        // Check if the current service has dependent services
+        if( services.get_schedule( i ).has_dependent_service ) {
+
+            // Normalize all dependent service names using std::transform
+            std::transform( service.dependent.begin( ), service.dependent.end( ), service.dependent.begin( ), []( std::string& service_name ) {
+                _normalized_service_name( service_name );
+                return service_name;
+            });
+
+        }
+    }
+}
+
+void service_handler_t::build_registry( service_table_t& services, service_registry_t& registry ) {
+
+    _normalize_service_names( services );
+
+    std::vector<std::string> unknown;
+    registry.build( services, unknown );
+
+    for ( const auto& edge : unknown ) {
+        _logger->info( "Dependent service \"", edge, "\" not found; ignored" );
+    }
 }
 
 int service_handler_t::prepare( ) {
@@ -67,31 +389,16 @@ int service_handler_t::prepare( ) {
 
 #ifdef USE_HTTP_DAY_STATUS
         _load_config(
-            _services, dust_configs, http_server, http_port 
+            _services, dust_configs, _handler_config, http_server, http_port 
         );
 #else
         _load_config(
-            _services, dust_configs 
+            _services, dust_configs, _handler_config 
         );
 #endif //!USE_HTTP_DAY_STATUS
 
-        // Iterate through all services in the `_services` list
-        for ( const auto& service : _services ) {
-
-            // Normalize the primary service name by ensuring it has the correct extension
-            _normalized_service_name( service->service_name );
-
-            // Check if the current service has dependent services
-            if( service->has_dependent_service ) {
-
-                // Normalize all dependent service names using std::transform
-                std::transform( service->dependent.begin( ), service->dependent.end( ), service->dependent.begin( ), []( std::string& service_name ) {
-                    _normalized_service_name( service_name );
-                    return service_name;
-                });
-
-            }
-        }
+        // Resolve the dependency graph once; a cycle fails the startup
+        build_registry( _services, _registry );
 
     } catch( std::exception& w ) {
 
@@ -109,7 +416,52 @@ int service_handler_t::prepare( ) {
     _http = new http_client( http_server , http_port );
 #endif //!USE_HTTP_DAY_STATUS
 
-    _svc_manager = new service_manager_t;
+    // Signals of watched units are dispatched on the monitor loop, which wakes up for them
+    _svc_manager = _backend_factory( true ).release( );
+
+    // Dispatched on the monitor loop as well; a changed unit is queried again in the same pass
+    _svc_manager->set_state_listener( [this]( const std::string& service_name, unit_active_state /*active_state*/ ) {
+        invalidate_status( _registry.find( service_name ) );
+    });
+
+    // Actions run on the workers; they wake the monitor loop with each result
+    _workers = new service_worker_pool_t( static_cast<size_t>( _handler_config.workers ), JOB_WAIT_MS, _backend_factory, [this]( ) {
+        _reactor.wake( );
+    });
+
+    if ( attach_event_sources( ) == 0 ) {
+        _logger->flush( );
+        return 0;
+    }
+
+    // Not critical, the manager runs unattended either way
+    if ( _control.open( CONTROL_SOCKET_PATH, [this]( const std::string& command, const std::vector<std::string>& args, std::vector<std::string>& lines ) {
+        return on_control_request( command, args, lines );
+    }) < 0 ) {
+        _logger->error( "Unable to open control socket \"", CONTROL_SOCKET_PATH, "\"" );
+        _logger->error( _control.get_last_error( ) );
+    }
+
+    // Without it the manager still runs, it just queries every unit on the next start
+    if ( _snapshot.open( STATE_SNAPSHOT_PATH ) < 0 ) {
+        _logger->error( "Unable to open state snapshot \"", STATE_SNAPSHOT_PATH, "\"" );
+        _logger->error( _snapshot.get_last_error( ) );
+    }
+
+    if ( _handler_config.metrics_port > 0 && _metrics_server.open( _handler_config.metrics_port ) < 0 ) {
+        _logger->error( "Unable to open metrics listener on 127.0.0.1:", _handler_config.metrics_port );
+        _logger->error( _metrics_server.get_last_error( ) );
+    }
+
+    for ( size_t i = 0; i < _services.size( ); i++ ) {
+
+        const svc_config& service = _services.get_config( i );
+
+        if ( _svc_manager->watch( service.service_name ) < 0 ) {
+            _logger->error( "Unable to watch service: \"", service.service_name, "\"; falling back to polling" );
+            _logger->error( _svc_manager->get_last_error( ) );
+        }
+    }
 
     if ( !_cleaner->is_empty( ) ) {
         _cleaner->clean( _logger );
@@ -120,12 +472,22 @@ int service_handler_t::prepare( ) {
 
 service_handler_t::~service_handler_t( ) {
 
+    // Its stages use the HTTP client and the cleaner released below
+    _pipeline.stop( );
+
+    // Suspended cascades release their services on destruction, before the tables go
+    _executor.clear( );
+
 #ifdef USE_HTTP_DAY_STATUS
     if ( _http != nullptr ) {
         delete _http;
     }
 #endif //!USE_HTTP_DAY_STATUS
 
+    if ( _workers != nullptr ) {
+        delete _workers;
+    }
+
     if ( _svc_manager != nullptr ) {
         delete _svc_manager;
     }
@@ -139,17 +501,6 @@ service_handler_t::~service_handler_t( ) {
         _logger->close( );
         _logger.reset( );
     }
-
-    if ( !_services.empty( ) ) {
-
-        for( const auto& service : _services ) {
-            delete service->time_range;
-            delete service;
-        }
-
-        _services.clear();
-
-    }
     
 }
 constexpr char CACH_FILE_PATH[]= "./svcm/cache.d";
@@ -254,7 +605,7 @@ int service_handler_t::load_day_status_fallback( ) {
 }
 
 
-int service_handler_t::load_day_status( ) {
+int service_handler_t::load_day_status( const std::string& date, const std::function<int( long )>& sleep_for ) {
 
     std::string body;
 
@@ -263,15 +614,29 @@ int service_handler_t::load_day_status( ) {
 
     _logger->info( "Loading trade date from host: \"", _http->get_host(), "\"" );
 
+    static metric_histogram_t& fetch_latency = _metrics( ).histogram( "svcm_trade_date_fetch_duration_seconds", "Latency of trade date requests." );
+    static metric_counter_t& fetch_retries = _metrics( ).counter( "svcm_trade_date_fetch_retries_total", "Trade date requests repeated after a failure." );
+
     while ( try_count < max_retries ) {
+
+        if ( try_count > 0 ) {
+            fetch_retries.add( );
+        }
+
         try_count++;
 
-        if ( _http->get( "/svc/trade-date", body ) == 0 ) {
+        int fetched;
+        {
+            metric_timer_t timer( fetch_latency );
+            fetched = _http->get( "/svc/trade-date", body );
+        }
+
+        if ( fetched == 0 ) {
 
             _logger->error( "HTTP request failed: ", _http->get_last_error( ) );
 
             // Exponential backoff (e.g., 1sec, 2sec, 3sec, ...)
-            if ( wait_for( ( 1000 * try_count ) ) == 0 ) {
+            if ( sleep_for( 1000 * try_count ) == 0 ) {
                 return 0;
             }
 
@@ -284,7 +649,7 @@ int service_handler_t::load_day_status( ) {
             _logger->error( "HTTP response has no body" );
 
             // Exponential backoff (e.g., 1sec, 2sec, 3sec, ...)
-            if ( wait_for( ( 1000 * try_count ) ) == 0 ) {
+            if ( sleep_for( 1000 * try_count ) == 0 ) {
                 return 0;
             }
 
@@ -296,7 +661,7 @@ int service_handler_t::load_day_status( ) {
             _logger->error( "Invalid date in HTTP response. Body:", body );
 
             // Exponential backoff (e.g., 1sec, 2sec, 3sec, ...)
-            if ( wait_for( ( 1000 * try_count ) ) == 0 ) {
+            if ( sleep_for( 1000 * try_count ) == 0 ) {
                 return 0;
             }
 
@@ -305,11 +670,14 @@ int service_handler_t::load_day_status( ) {
 
         _logger->info( "Trade Date found \"", body, "\"" );
 
-        _is_working_day = _last_date == body;
+        const bool working_day = date == body;
 
-        _logger->info( "Current Date: \"", _last_date, "\" is working day : \"", ( _is_working_day ? "true" : "false" ), "\"" );
+        // Swapped in as a whole, the monitor loop may be reading it meanwhile
+        _is_working_day.store( working_day );
 
-        if ( !_is_working_day ) {
+        _logger->info( "Current Date: \"", date, "\" is working day : \"", ( working_day ? "true" : "false" ), "\"" );
+
+        if ( !working_day ) {
             _logger->info( "Next working day found \"", body, "\"" );
         }
 
@@ -324,196 +692,853 @@ int service_handler_t::load_day_status( ) {
 
 #endif //!USE_HTTP_DAY_STATUS
 
-void service_handler_t::restart_service(svc_config& service) {
-    _logger->info( "Re-Starting service: \"", service.service_name, "\"" );
+void service_handler_t::drain_actions( ) {
 
-    if ( _svc_manager->restart( service.service_name ) == 1 ) {
+    std::vector<action_result> results;
 
-        service.state = service_state::ACTIVE;
-        _logger->info( "\"", service.service_name, "\" restarted" );
+    if ( _workers->drain( results ) == 0 ) return;
 
-    } else {
+    _state_dirty = true;
 
-        _logger->error( "Failed to re-start service: \"", service.service_name, "\"" );
-        _logger->error( _svc_manager->get_last_error( ) );
+    for ( const auto& result : results ) {
 
-    }
-}
+        const svc_config& service = _services.get_config( result.service_index );
+        svc_schedule& schedule = _services.get_schedule( result.service_index );
 
-void service_handler_t::start_service( svc_config& service ) {
+        schedule.pending_actions--;
 
-    _logger->info( "Starting service: \"", service.service_name, "\"" );
+        const std::string labels = _metric_label( "service", service.service_name ) + "," + _metric_label( "action", _service_action_name( result.action ) );
 
-    if ( _svc_manager->start( service.service_name ) == 1 ) {
+        _metrics( ).counter( "svcm_service_actions_total", "Start, stop and restart actions run, per service.", labels ).add( );
 
-        service.state = service_state::ACTIVE;
-        _logger->info( "\"", service.service_name, "\" status change to active" );
+        if ( result.status < 0 || result.result != job_result::DONE ) {
+            _metrics( ).counter( "svcm_service_action_failures_total", "Actions that failed or whose job did not finish with \"done\", per service.", labels ).add( );
+        }
 
-    } else {
+        if ( result.status < 0 ) {
+            _logger->error( "Failed to ", _service_action_name( result.action ), " service: \"", service.service_name, "\"" );
+            _logger->error( result.error );
+            continue;
+        }
 
-        _logger->error( "Failed to start service: \"", service.service_name, "\"" );
-        _logger->error( _svc_manager->get_last_error( ) );
+        switch ( result.action ) {
+            case service_action::START:
+                schedule.state = service_state::ACTIVE;
+                _logger->info( "\"", service.service_name, "\" status change to active" );
+                break;
+            case service_action::STOP:
+                schedule.state = service_state::INACTIVE;
+                _logger->info( "\"", service.service_name, "\" status change to in-active" );
+                break;
+            case service_action::RESTART:
+                schedule.state = service_state::ACTIVE;
+                _logger->info( "\"", service.service_name, "\" restarted" );
+                break;
+            case service_action::RETRY:
+                schedule.state = service_state::ACTIVE;
+                _logger->info( "\"", service.service_name, "\" started after backoff" );
+                break;
+        }
 
+        if ( result.result != job_result::DONE ) {
+            _logger->error( "\"", service.service_name, "\" job finished with result: ", _job_result_name( result.result ) );
+        }
     }
-
 }
 
-void service_handler_t::stop_service( svc_config& service ) {
+bool service_handler_t::actions_finished( const std::vector<size_t>& indexes ) const {
 
-    _logger->info( "Stopping service: \"", service.service_name, "\"" );
+    for ( size_t index : indexes ) {
+        if ( _services.get_schedule( index ).pending_actions > 0 ) {
+            return false;
+        }
+    }
 
-    if( _svc_manager->stop( service.service_name ) == 1 ) {
+    return true;
+}
 
-        service.state = service_state::INACTIVE;
-        _logger->info( "\"", service.service_name, "\" status change to in-active" );
+service_executor_t::wait_awaiter service_handler_t::wait_for_actions( std::vector<size_t> indexes ) {
+    // A result arrives once its job finished; past the deadline the cascade goes on without it
+    auto deadline = service_executor_t::clock::now( ) + std::chrono::milliseconds( 2 * JOB_WAIT_MS );
 
-    } else {
+    return _executor.wait_until( deadline, [this, indexes = std::move( indexes )]( ) {
+        return actions_finished( indexes );
+    });
+}
 
-        _logger->error( "Failed to stop service: \"", service.service_name, "\"" );
-        _logger->error( _svc_manager->get_last_error( ) );
+void service_handler_t::submit_action( size_t index, service_action action ) {
+    // The action changes what this pass knows about the service
+    invalidate_status( index );
+    _services.get_schedule( index ).pending_actions++;
+    _workers->submit( index, _services.get_config( index ).service_name, action );
+}
 
-    }
+void service_handler_t::restart_service( size_t index ) {
+    _logger->info( "Re-Starting service: \"", _services.get_config( index ).service_name, "\"" );
+    submit_action( index, service_action::RESTART );
+}
 
+void service_handler_t::start_service( size_t index ) {
+    _logger->info( "Starting service: \"", _services.get_config( index ).service_name, "\"" );
+    submit_action( index, service_action::START );
 }
 
-constexpr char SERVICE_ACTIVE[] = "active";
-constexpr char SERVICE_INACTIVE[] = "inactive";
-constexpr char SERVICE_ACTIVATING[] = "activating";
-constexpr char SERVICE_DEACTIVATING[] = "deactivating";
+void service_handler_t::start_scheduled_service( size_t index, const std::time_t& now_time ) {
 
-service_state service_handler_t::get_service_status( const svc_config& service ) {
+    const svc_config& service = _services.get_config( index );
+    svc_schedule& schedule = _services.get_schedule( index );
 
-    std::string result;
+    _state_dirty = true;
 
-    if ( _svc_manager->get_status( service.service_name, result ) < 0 ) {
+    // The backoff expired; clear the failed state, systemd would refuse a rate limited unit
+    if ( schedule.retry_epoch != 0 ) {
 
-        _logger->error( "Failed to check status of service: \"", service.service_name, "\"" );
-        _logger->error( _svc_manager->get_last_error( ) );
-        // here we mean that this service failed or not running
-        return service_state::INACTIVE;
+        _logger->info( "Retrying \"", service.service_name, "\" after backoff; Failed starts: ", schedule.start_failures );
+
+        schedule.retry_epoch = 0;
+        schedule.last_start_epoch = now_time;
+        submit_action( index, service_action::RETRY );
+
+        return;
+    }
 
+    // Needed again soon after the previous start, so it did not stay up
+    if ( schedule.last_start_epoch != 0 && now_time - schedule.last_start_epoch < _handler_config.backoff.window ) {
+        schedule.start_failures++;
+    } else {
+        schedule.start_failures = 0;
     }
 
-    if ( result != SERVICE_ACTIVE ) {
+    if ( schedule.start_failures >= _handler_config.backoff.threshold ) {
+        back_off_service( index, now_time );
+        return;
+    }
 
-        _logger->info( "Service: \"", service.service_name, "\" Status found :", result );
+    // This means the service failed or is not running; we need to restart it
+    _logger->info( "\"", service.service_name, "\" status inactive. We've to start." );
 
-        if ( result == SERVICE_DEACTIVATING ) {
-            return service_state::INACTIVE;
-        }
+    schedule.last_start_epoch = now_time;
+    start_service( index );
+}
 
-        if ( result == SERVICE_ACTIVATING ) {
-            return service_state::ACTIVE;
-        }
+void service_handler_t::back_off_service( size_t index, const std::time_t& now_time ) {
 
-        return service_state::INACTIVE;
-    }
+    const backoff_config& backoff = _handler_config.backoff;
+    const svc_config& service = _services.get_config( index );
+    svc_schedule& schedule = _services.get_schedule( index );
 
-    return service_state::ACTIVE;
-    
-}
+    // initial, 2 * initial, 4 * initial, ... up to max
+    int doublings = std::min( schedule.start_failures - backoff.threshold, 30 );
+    long delay = std::min( static_cast<long>( backoff.initial ) << doublings, static_cast<long>( backoff.max ) );
 
-void service_handler_t::update_service_current_state( ) {
-    // update service current status
-    for ( const auto& service : _services ) {
+    // Drawn from the upper three quarters, so services failing together retry apart
+    std::uniform_int_distribution<long> jitter( delay - delay / 4, delay );
+    delay = jitter( _jitter );
 
-        _logger->debug( "Prepare service : \"", service->service_name, "\"" );
-        service->time_range->print( _logger );
+    schedule.state = service_state::FAILED_BACKOFF;
+    schedule.retry_epoch = now_time + delay;
 
-        if ( get_service_status( *service ) == service_state::ACTIVE ) {
-            
-            service->state = service_state::ACTIVE;
-            _logger->debug( "\"", service->service_name, "\" Service status : Active" );
+    _scheduler.schedule( schedule.retry_epoch, index, schedule_event::RETRY );
 
-        } else {
+    _metrics( ).counter( "svcm_service_backoffs_total", "Times a service was parked after repeated failed starts.", _metric_label( "service", service.service_name ) ).add( );
 
-            service->state = service_state::INACTIVE;
-            _logger->debug( "\"", service->service_name, "\" Service status : Inactive" );
-            
-        }
-    }
+    _logger->error( "\"", service.service_name, "\" failed to start ", schedule.start_failures, " times in a row; next attempt in ", delay, " sec" );
 }
 
-int service_handler_t::toggel_dependent_service(
-    const std::string& root_service,
-    const std::vector<std::string>& dependent, 
-    const std::time_t& now_time, 
-    bool stop 
-) {
-    int count = 0; // Counter for successfully toggled services
+void service_handler_t::clear_backoff( size_t index ) {
 
-    // Ensure there are dependent services to process
-    if ( !dependent.empty( ) ) {
+    svc_schedule& schedule = _services.get_schedule( index );
 
-        _logger->info( "Iterate through each dependent service of \"", root_service, "\"" );
+    _state_dirty = true;
 
-        // Iterate over each dependent service
-        for ( const auto& service_name : dependent ) {
+    // It may have come up meanwhile, e.g. through systemd's Restart=
+    if ( schedule.state == service_state::FAILED_BACKOFF ) {
+        schedule.state = get_service_status( index ) == service_state::ACTIVE ? service_state::ACTIVE : service_state::INACTIVE;
+    }
 
-            if ( _exit_flag.load( ) == 1 ) break;
+    // A queued RETRY boundary only causes one extra pass
+    schedule.start_failures = 0;
+    schedule.last_start_epoch = 0;
+    schedule.retry_epoch = 0;
+}
 
-            // Locate the service configuration using a linear search
-            auto it = std::find_if( _services.begin( ), _services.end( ), [&service_name]( svc_config* svc ) {
-                return svc && svc->service_name == service_name;
-            });
+void service_handler_t::stop_service( size_t index ) {
+    _logger->info( "Stopping service: \"", _services.get_config( index ).service_name, "\"" );
+    submit_action( index, service_action::STOP );
+}
 
-            // If the service is not found, log and skip
-            if (it == _services.end( ) || !(*it)) {
-                _logger->info("Service \"", service_name, "\" not found");
-                continue;
-            }
+/**
+ * @brief Maps a systemd `ActiveState` to a service state.
+ *
+ * "activating" counts as active, anything else but "active" as inactive.
+ */
+service_state _to_service_state( unit_active_state state ) {
 
-            // Retrieve the service configuration object
-            svc_config* service = *it;
+    if ( state == unit_active_state::ACTIVE || state == unit_active_state::ACTIVATING ) {
+        return service_state::ACTIVE;
+    }
 
-            // Fetch the current state of the service
-            service_state state = get_service_status( *service );
+    return service_state::INACTIVE;
+}
 
-            if ( stop ) {
-                // Stop the service if it's not already inactive
-                if ( state != service_state::INACTIVE ) {
-                    
-                    // Recursively stop all dependent services before stopping this service
-                    if( service->has_dependent_service && toggel_dependent_service( service->service_name, service->dependent, now_time, stop ) > 0 ) {
-
-                        // Wait for up to 10 seconds for the dependent service to stop
-                        // If `wait_for(10000)` returns 0, it indicates a timeout or successful stop
-                        // In case of a timeout, break out of the loop to avoid further processing
-                        if ( wait_for( 10000 ) == 0 ) {
-                            break;
-                        }
-                    }
-
-                    stop_service( *service ); // Stop the service
-                    service->is_restarted = true; // Mark the service for restart tracking
-
-                    count++; // Increment toggled service count
-                }
-                continue; // Skip further processing since we are stopping services
+service_state service_handler_t::query_service_status( const svc_config& service ) {
+
+    unit_status status;
+
+    // Watched services are answered from the state table, others need a D-Bus round-trip
+    if ( _svc_manager->get_cached_status( service.service_name, status ) == 0 &&
+        _svc_manager->get_status( service.service_name, status ) < 0 ) {
+
+        _logger->error( "Failed to check status of service: \"", service.service_name, "\"" );
+        _logger->error( _svc_manager->get_last_error( ) );
+        // here we mean that this service failed or not running
+        return service_state::INACTIVE;
+
+    }
+
+    if ( status.active_state != unit_active_state::ACTIVE ) {
+        _logger->info(
+            "Service: \"", service.service_name, "\" Status found :", _unit_active_state_name( status.active_state ),
+            " (", _unit_sub_state_name( status.sub_state ), "); Exit status: ", status.exec_main_status,
+            "; Restarts: ", status.restarts
+        );
+    }
+
+    return _to_service_state( status.active_state );
+    
+}
+
+void service_handler_t::query_service_states( std::vector<service_state>& states ) {
+
+    std::vector<std::string> names;
+    names.reserve( _services.size( ) );
+
+    for ( size_t i = 0; i < _services.size( ); i++ ) {
+        names.push_back( _services.get_config( i ).service_name );
+    }
+
+    std::vector<unit_status> results;
+
+    states.clear( );
+    states.reserve( _services.size( ) );
+
+    if ( _svc_manager->get_status_many( names, results ) < 0 ) {
+
+        _logger->error( "Failed to check status of services in bulk" );
+        _logger->error( _svc_manager->get_last_error( ) );
+
+        for ( size_t i = 0; i < _services.size( ); i++ ) {
+            states.push_back( query_service_status( _services.get_config( i ) ) );
+        }
+
+        return;
+    }
+
+    for ( const auto& result : results ) {
+        states.push_back( _to_service_state( result.active_state ) );
+    }
+}
+
+service_state service_handler_t::get_service_status( size_t index ) {
+
+    static metric_counter_t& queries = _metrics( ).counter( "svcm_status_queries_total", "Service status queries, bulk ones counted per service." );
+    static metric_counter_t& hits = _metrics( ).counter( "svcm_status_memo_hits_total", "Service status lookups answered by the per pass memo." );
+
+    if ( index < _status_memo.size( ) && _status_memo[index] >= 0 ) {
+        _status_memo_hits++;
+        hits.add( );
+        return static_cast<service_state>( _status_memo[index] );
+    }
+
+    // The first miss of an unwatched service fetches all unwatched ones in one call
+    if ( _status_bulk_pending && index < _status_memo.size( ) ) {
+
+        unit_status status;
+
+        if ( _svc_manager->get_cached_status( _services.get_config( index ).service_name, status ) == 0 ) {
+
+            _status_bulk_pending = false;
+            fill_status_memo( );
+
+            if ( _status_memo[index] >= 0 ) {
+                return static_cast<service_state>( _status_memo[index] );
+            }
+        }
+    }
+
+    service_state state = query_service_status( _services.get_config( index ) );
+
+    _status_query_total++;
+    queries.add( );
+
+    if ( index < _status_memo.size( ) ) {
+        _status_memo[index] = static_cast<signed char>( state );
+        _status_max_queries = std::max<unsigned>( _status_max_queries, ++_status_queries[index] );
+    }
+
+    return state;
+}
+
+void service_handler_t::begin_status_pass( ) {
+    _status_memo.assign( _services.size( ), -1 );
+    _status_queries.assign( _services.size( ), 0 );
+    // Passes woken by the control socket or a scrape often need no status at all
+    _status_bulk_pending = true;
+}
+
+void service_handler_t::fill_status_memo( ) {
+
+    static metric_counter_t& queries = _metrics( ).counter( "svcm_status_queries_total", "Service status queries, bulk ones counted per service." );
+
+    // Watched services are answered from memory anyway
+    std::vector<size_t> indexes;
+    std::vector<std::string> names;
+    unit_status status;
+
+    for ( size_t i = 0; i < _services.size( ); i++ ) {
+
+        const std::string& name = _services.get_config( i ).service_name;
+
+        if ( _svc_manager->get_cached_status( name, status ) == 0 ) {
+            indexes.push_back( i );
+            names.push_back( name );
+        }
+    }
+
+    // A single one is queried when, and only if, it is needed
+    if ( indexes.size( ) < 2 ) return;
+
+    std::vector<unit_status> results;
+
+    if ( _svc_manager->get_status_many( names, results ) < 0 ) {
+        // Left to the single queries
+        return;
+    }
+
+    for ( size_t i = 0; i < indexes.size( ); i++ ) {
+        _status_memo[indexes[i]] = static_cast<signed char>( _to_service_state( results[i].active_state ) );
+        _status_queries[indexes[i]] = 1;
+    }
+
+    _status_query_total += indexes.size( );
+    _status_max_queries = std::max( _status_max_queries, 1u );
+    queries.add( indexes.size( ) );
+}
+
+void service_handler_t::invalidate_status( size_t index ) {
+    if ( index < _status_memo.size( ) ) {
+        _status_memo[index] = -1;
+    }
+}
+
+void service_handler_t::sync_service_state( ) {
+    // The bulk query refreshes the state table of watched services
+    std::vector<service_state> states;
+    query_service_states( states );
+}
+
+void service_handler_t::update_service_current_state( ) {
+
+    std::vector<service_state> states;
+    query_service_states( states );
+
+    // update service current status
+    for ( size_t i = 0; i < _services.size( ); i++ ) {
+
+        const svc_config& service = _services.get_config( i );
+        svc_schedule& schedule = _services.get_schedule( i );
+
+        _logger->debug( "Prepare service : \"", service.service_name, "\"" );
+        schedule.time_range.print( _logger );
+
+        if ( states[i] == service_state::ACTIVE ) {
+            
+            schedule.state = service_state::ACTIVE;
+            _logger->debug( "\"", service.service_name, "\" Service status : Active" );
+
+        } else {
+
+            schedule.state = service_state::INACTIVE;
+            _logger->debug( "\"", service.service_name, "\" Service status : Inactive" );
+            
+        }
+    }
+}
+
+int service_handler_t::resume_service_state( ) {
+
+    int restored = _snapshot.restore( _last_date, _registry, _services );
+
+    if ( restored == 0 ) return 0;
+
+    // Validation sweep; watched units are answered from memory, so this is not a D-Bus round-trip per unit
+    for ( size_t i = 0; i < _services.size( ); i++ ) {
+
+        const svc_config& service = _services.get_config( i );
+        svc_schedule& schedule = _services.get_schedule( i );
+
+        unit_status status;
+        service_state state;
+
+        if ( _svc_manager->get_cached_status( service.service_name, status ) == 1 ) {
+            state = _to_service_state( status.active_state );
+        } else {
+            state = query_service_status( service );
+        }
+
+        if ( state == service_state::ACTIVE ) {
+            // Came up meanwhile, the failures stay counted should it drop again
+            schedule.state = service_state::ACTIVE;
+            schedule.retry_epoch = 0;
+        } else {
+            schedule.state = schedule.retry_epoch != 0 ? service_state::FAILED_BACKOFF : service_state::INACTIVE;
+        }
+    }
+
+    _logger->info( "Resumed state of ", restored, " service(s) from \"", STATE_SNAPSHOT_PATH, "\"" );
+
+    return 1;
+}
+
+void service_handler_t::persist_service_state( ) {
+
+    if ( !_state_dirty || !_snapshot.is_open( ) ) return;
+
+    _state_dirty = false;
+
+    if ( _snapshot.save( _last_date, _services ) < 0 ) {
+        _logger->error( "Unable to save state snapshot \"", STATE_SNAPSHOT_PATH, "\"" );
+        _logger->error( _snapshot.get_last_error( ) );
+    }
+}
+
+service_task service_handler_t::toggle_dependency_level(
+    std::vector<size_t> level,
+    std::time_t now_time,
+    bool stop
+) {
+    const size_t max_parallel = static_cast<size_t>( _handler_config.max_parallel );
+
+    std::vector<size_t> batch;
+
+    for ( size_t i = 0; i < level.size( ); i += max_parallel ) {
+
+        batch.clear( );
+
+        // Queue one batch of actions, the workers run them concurrently
+        for ( size_t j = i; j < level.size( ) && j < i + max_parallel; j++ ) {
+
+            if ( _exit_flag.load( ) == 1 ) co_return;
+
+            size_t index = level[j];
+            svc_schedule& schedule = _services.get_schedule( index );
+
+            // Fetch the current state of the service
+            service_state state = get_service_status( index );
+
+            if ( stop ) {
+                // Stop the service if it's not already inactive
+                if ( state == service_state::INACTIVE ) continue;
+
+                stop_service( index );
+
+            } else {
+                // If starting, ensure service is inactive and within its operational time range
+                if ( state != service_state::INACTIVE || !schedule.time_range.is_between_times( now_time ) ) continue;
+
+                // Left to its own retry
+                if ( schedule.retry_epoch > now_time ) continue;
+
+                start_service( index );
+
+            }
+
+            batch.push_back( index );
+            schedule.is_restarted = true; // Mark the service for restart tracking
+            _state_dirty = true;
+        }
+
+        // The batch is settled once every action finished
+        if ( !co_await wait_for_actions( batch ) ) {
+            _logger->error( "Dependency level below \"", _services.get_config( level[i] ).service_name, "\" did not settle; continuing" );
+        }
+    }
+}
+
+service_task service_handler_t::toggel_dependent_service(
+    size_t root_index,
+    std::time_t now_time, 
+    bool stop 
+) {
+    // Ensure there are dependent services to process
+    if ( _registry.get_dependents( root_index ).empty( ) ) co_return;
+
+    _logger->info( "Iterate through each dependent service of \"", _services.get_config( root_index ).service_name, "\"" );
+
+    std::vector<std::vector<size_t>> levels;
+    _registry.get_levels( root_index, levels );
+
+    for ( size_t i = 0; i < levels.size( ); i++ ) {
+
+        if ( _exit_flag.load( ) == 1 ) break;
+
+        // Stop from the deepest level up, start from the shallowest level down
+        co_await toggle_dependency_level( stop ? levels[levels.size( ) - 1 - i] : levels[i], now_time, stop );
+    }
+}
+
+service_task service_handler_t::restart_cascade( size_t index, std::time_t now_time ) {
+
+    // Releases what was acquired when the cascade ends, throws or is destroyed
+    struct cascade_guard {
+        service_table_t& services;
+        std::vector<size_t> members;
+        size_t acquired = 0;
+
+        ~cascade_guard( ) {
+            for ( size_t i = 0; i < acquired; i++ ) {
+                services.get_schedule( members[i] ).cascades--;
             }
+        }
+    } guard{ _services, { index } };
+
+    // The loop leaves every service of the cascade alone until it finished
+    std::vector<std::vector<size_t>> levels;
+    _registry.get_levels( index, levels );
+
+    for ( const auto& level : levels ) {
+        guard.members.insert( guard.members.end( ), level.begin( ), level.end( ) );
+    }
+
+    for ( ; guard.acquired < guard.members.size( ); guard.acquired++ ) {
+        _services.get_schedule( guard.members[guard.acquired] ).cascades++;
+    }
 
-            // If starting, ensure service is inactive and within its operational time range
-            if ( state == service_state::INACTIVE && service->time_range->is_between_times( now_time ) ) {
-
-                start_service( *service ); // Start the service
-                service->is_restarted = true; // Mark the service for restart tracking
-
-                // Recursively start all dependent services after the restart
-                if ( service->has_dependent_service && toggel_dependent_service( service->service_name, service->dependent, now_time, stop ) > 0 ) {
-                    
-                    // Wait for up to 10 seconds for the dependent service to start
-                    // If `wait_for(10000)` returns 0, it indicates a timeout or successful start
-                    // In case of a timeout, break out of the loop to avoid further processing
-                    if ( wait_for( 10000 ) == 0 ) {
-                        break;
-                    }
+    // Stop all dependent services before restarting this service,
+    // each stop is awaited, so they are down once this resumes
+    co_await toggel_dependent_service( index, now_time, true );
+
+    if ( _exit_flag.load( ) == 0 ) {
+
+        restart_service( index );
+
+        // Give the service exactly the time systemd needs to restart it
+        co_await wait_for_actions( std::vector<size_t>( 1, index ) );
+
+        // Start all dependent services again after the restart, within their time range as of now
+        if ( _exit_flag.load( ) == 0 ) {
+            co_await toggel_dependent_service( index, std::chrono::system_clock::to_time_t( std::chrono::system_clock::now( ) ), false );
+        }
+    }
+}
+
+void service_handler_t::spawn_cascade( size_t index, std::time_t now_time ) {
+
+    _executor.spawn( restart_cascade( index, now_time ), [this, index]( std::exception_ptr exception ) {
+
+        try {
+            std::rethrow_exception( exception );
+        } catch ( const std::exception& e ) {
+            _logger->error( "Restart cascade of \"", _services.get_config( index ).service_name, "\" failed: ", e.what( ) );
+        } catch ( ... ) {
+            _logger->error( "Restart cascade of \"", _services.get_config( index ).service_name, "\" failed" );
+        }
+    });
+}
+
+void service_handler_t::process_service( size_t index, const std::time_t& now_time, bool restart_due ) {
+
+    const svc_config& service = _services.get_config( index );
+    svc_schedule& schedule = _services.get_schedule( index );
+
+    // Check if the service requires a workday
+    if ( schedule.required_workday ) {
+
+        // Decided once the day's status is in
+        if ( _day_status_pending ) return;
+
+        // If it's not a working day
+        if ( !_is_working_day ) {
+
+            // Check if the service is currently active
+            if (schedule.state == service_state::ACTIVE) {
+                
+                // If the service is still active according to its status, stop the service
+                if ( get_service_status( index ) == service_state::ACTIVE ) {
+                    stop_service( index );
+                } else {
+                    // Force close request if the service is not active
+                    _logger->info( "Initiate \"", service.service_name, "\" force close (1)" );
+                    stop_service( index );
+                }
+            }
+
+            // Skip the rest and move to the next service (if applicable)
+            return;
+        }
+    }
+
+    // Check if the service supports restart functionality
+    if ( schedule.is_restart_support ) {
+
+        // If the service has not been restarted yet
+        if ( !schedule.is_restarted ) {
+
+            // Check if the service needs a restart based on the current time,
+            // or its restart boundary fired late and has to be caught up
+            if ( restart_due || schedule.time_range.need_restart( now_time ) ) {
+
+                // Mark the service as restarted to prevent redundant restarts
+                schedule.is_restarted = true;
+                _state_dirty = true;
+
+                if( schedule.has_dependent_service ) {
+                    // Stop dependents, restart, start dependents; runs interleaved with the loop
+                    spawn_cascade( index, now_time );
+                } else {
+                    // Restart the service if needed
+                    restart_service( index );
                 }
-                count++; // Increment toggled service count
+
+                // Skip to the next service
+                return;
+            }
+        }
+    }
+
+    // Check if the service is within its active time range
+    if ( schedule.time_range.is_between_times( now_time ) ) {
+
+        // Parked after repeated failures; not even its status is checked until the retry
+        if ( schedule.retry_epoch > now_time ) return;
+
+        service_state state = get_service_status( index );
+
+        // If the service is currently inactive
+        if ( state == service_state::INACTIVE ) {
+            start_scheduled_service( index, now_time );
+        } else if ( state == service_state::ACTIVE && ( schedule.state != service_state::ACTIVE || schedule.retry_epoch != 0 ) ) {
+
+            // Came up without us, e.g. through systemd's Restart= while backing off
+            if ( schedule.retry_epoch != 0 ) {
+                _logger->info( "\"", service.service_name, "\" is active again; backoff cleared" );
+            }
+
+            schedule.state = service_state::ACTIVE;
+            schedule.retry_epoch = 0;
+            schedule.start_failures = 0;
+            _state_dirty = true;
+        }
+
+        // Skip the rest and move to the next service (if applicable)
+        return;
+    }
+
+    // A new time range starts without the failures of the previous one
+    if ( schedule.state == service_state::FAILED_BACKOFF ) {
+        _logger->info( "\"", service.service_name, "\" left its time range; backoff cleared" );
+        clear_backoff( index );
+    }
+
+    // If the service is active
+    if ( schedule.state == service_state::ACTIVE ) {
+
+        // Check if the service is still active based on its current status
+        if ( get_service_status( index ) == service_state::ACTIVE ) {
+            // Stop the active service
+            stop_service( index );
+        } else {
+            // Force close the service if it’s not active, and log the request
+            _logger->info( "Initiate \"", service.service_name, "\" force close (2)" );
+            stop_service( index );
+        }
+    }
+}
+
+void service_handler_t::rebuild_schedule( const std::time_t& now_time ) {
+
+    _scheduler.clear( );
+
+    for ( size_t i = 0; i < _services.size( ); i++ ) {
+
+        const time_range_t& time_range = _services.get_schedule( i ).time_range;
+
+        // Only upcoming boundaries; those already behind us are covered by the evaluation pass
+        if ( time_range.get_start_epoch( ) > now_time ) {
+            _scheduler.schedule( time_range.get_start_epoch( ), i, schedule_event::START );
+        }
+
+        // The end itself is still inside the range, the service leaves it a second later
+        if ( time_range.get_end_epoch( ) > 0 && time_range.get_end_epoch( ) + 1 > now_time ) {
+            _scheduler.schedule( time_range.get_end_epoch( ) + 1, i, schedule_event::END );
+        }
+
+        if ( time_range.get_restart_epoch( ) > now_time ) {
+            _scheduler.schedule( time_range.get_restart_epoch( ), i, schedule_event::RESTART );
+        }
+
+        if ( _services.get_schedule( i ).retry_epoch > now_time ) {
+            _scheduler.schedule( _services.get_schedule( i ).retry_epoch, i, schedule_event::RETRY );
+        }
+    }
+}
+
+bool service_handler_t::is_idle( ) const {
+
+    if ( _executor.size( ) > 0 ) return false;
+
+    // The stages use the HTTP client and the dust rules a reload replaces
+    if ( _pipeline.is_running( ) ) return false;
+
+    for ( size_t i = 0; i < _services.size( ); i++ ) {
+        if ( _services.get_schedule( i ).pending_actions > 0 ) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+int service_handler_t::reload_config( ) {
+
+    auto started = service_reactor_t::clock::now( );
+
+    service_table_t services;
+    service_registry_t registry;
+    handler_config config;
+    std::vector<dust_clean_config*> dust_configs;
+
+#ifdef USE_HTTP_DAY_STATUS
+    std::string http_port;
+    std::string http_server;
+#endif //!USE_HTTP_DAY_STATUS
+
+    try {
+
+#ifdef USE_HTTP_DAY_STATUS
+        _load_config(
+            services, dust_configs, config, http_server, http_port 
+        );
+#else
+        _load_config(
+            services, dust_configs, config 
+        );
+#endif //!USE_HTTP_DAY_STATUS
+
+        build_registry( services, registry );
+
+    } catch( std::exception& w ) {
+
+        _logger->error( "Failed to reload \"./svcm/config.json\"; keeping the running configuration" );
+        _logger->error( w.what() );
+
+        for ( const auto& dust_config : dust_configs ) {
+            delete dust_config;
+        }
+
+        return 0;
+
+    }
+
+    size_t added = 0, changed = 0, removed = 0;
+
+    for ( size_t i = 0; i < services.size( ); i++ ) {
+
+        const svc_config& service = services.get_config( i );
+        svc_schedule& schedule = services.get_schedule( i );
+
+        size_t old_index = _registry.find( service.service_name );
+
+        if ( old_index == service_registry_t::npos ) {
+
+            added++;
+            _logger->info( "Service added: \"", service.service_name, "\"" );
+            schedule.time_range.print( _logger );
+
+            if ( _svc_manager->watch( service.service_name ) < 0 ) {
+                _logger->error( "Unable to watch service: \"", service.service_name, "\"; falling back to polling" );
+                _logger->error( _svc_manager->get_last_error( ) );
             }
+
+            schedule.state = query_service_status( service );
+            continue;
         }
+
+        const svc_config& old_service = _services.get_config( old_index );
+        const svc_schedule& old_schedule = _services.get_schedule( old_index );
+
+        if ( schedule.time_range.equals( old_schedule.time_range ) &&
+            schedule.required_workday == old_schedule.required_workday &&
+            service.dependent == old_service.dependent ) {
+            // Untouched, including today's restart bookkeeping
+            schedule = old_schedule;
+            continue;
+        }
+
+        changed++;
+        _logger->info( "Service changed: \"", service.service_name, "\"" );
+        schedule.time_range.print( _logger );
+
+        schedule.state = old_schedule.state;
+        schedule.start_failures = old_schedule.start_failures;
+        schedule.last_start_epoch = old_schedule.last_start_epoch;
+        schedule.retry_epoch = old_schedule.retry_epoch;
+        // A moved restart time may still be due today
+        schedule.is_restarted = old_schedule.is_restarted &&
+            schedule.time_range.get_restart_epoch( ) == old_schedule.time_range.get_restart_epoch( );
+    }
+
+    for ( size_t i = 0; i < _services.size( ); i++ ) {
+
+        const svc_config& old_service = _services.get_config( i );
+
+        if ( registry.find( old_service.service_name ) != service_registry_t::npos ) continue;
+
+        // The unit keeps running or stays stopped, it is just no longer managed
+        removed++;
+        _logger->info( "Service removed: \"", old_service.service_name, "\"; left in its current state" );
+        _svc_manager->unwatch( old_service.service_name );
+    }
+
+    if ( config.workers != _handler_config.workers ) {
+        _logger->info( "config->workers change takes effect after restart" );
+        config.workers = _handler_config.workers;
+    }
+
+    if ( config.metrics_port != _handler_config.metrics_port ) {
+        _logger->info( "config->metrics change takes effect after restart" );
+        config.metrics_port = _handler_config.metrics_port;
+    }
+
+    _handler_config = config;
+    _services = std::move( services );
+    _registry = std::move( registry );
+
+    // The cleaner hands the previous rules back; the next day switch applies the new ones
+    _cleaner->set_dust_config( dust_configs );
+
+    for ( const auto& dust_config : dust_configs ) {
+        delete dust_config;
     }
 
-    return count; // Return the number of services successfully toggled
+#ifdef USE_HTTP_DAY_STATUS
+    if ( _http != nullptr ) {
+        delete _http;
+    }
+
+    _http = new http_client( http_server , http_port );
+#endif //!USE_HTTP_DAY_STATUS
+
+    rebuild_schedule( std::chrono::system_clock::to_time_t( std::chrono::system_clock::now( ) ) );
+
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>( service_reactor_t::clock::now( ) - started );
+
+    _logger->info(
+        "Reloaded \"./svcm/config.json\" in ", elapsed.count( ), " ms; Added: ", added,
+        "; Changed: ", changed, "; Removed: ", removed, "; Total Service: ", _services.size( )
+    );
+
+    return 1;
 }
 
 int service_handler_t::block( ) {
@@ -522,7 +1547,7 @@ int service_handler_t::block( ) {
 
 #ifdef USE_HTTP_DAY_STATUS
 
-    if ( load_day_status( ) == 0 ) {
+    if ( load_day_status( _last_date, [this]( long ms ) { return wait_for( ms ); } ) == 0 ) {
 
         if ( load_day_status_fallback() == 0 ) {
 
@@ -536,146 +1561,159 @@ int service_handler_t::block( ) {
     
  #endif //!USE_HTTP_DAY_STATUS
 
-    update_service_current_state( );
+    if ( resume_service_state( ) == 0 ) {
+        update_service_current_state( );
+    }
+
+    _state_dirty = true;
+
+    // The state table is re-read from systemd every 5 minutes
+    const auto sweep_interval = std::chrono::minutes( 5 );
+    auto next_sweep = service_reactor_t::clock::now( ) + sweep_interval;
 
-    const long delay_ms = 30000;
+    // Restart boundaries popped from the scheduler, per service
+    std::vector<char> restart_due( _services.size( ), 0 );
 
-    _logger->info( "Starting \"Service Manager\" with 30 sec delay monitor; Total Service: ", _services.size() );
+    rebuild_schedule( std::chrono::system_clock::to_time_t( std::chrono::system_clock::now( ) ) );
+
+    _logger->info( "Starting \"Service Manager\" with schedule boundary monitor; Total Service: ", _services.size(), "; Scheduled Boundary: ", _scheduler.size( ) );
 
     _logger->flush( );
 
+    // 0 once the background day switch failed
+    int status = 1;
+
+    metric_histogram_t& tick_duration = _metrics( ).histogram( "svcm_tick_duration_seconds", "Time spent in one pass of the monitor loop." );
+    metric_histogram_t& tick_lag = _metrics( ).histogram( "svcm_tick_lag_seconds", "Delay between a pass's deadline and the loop waking up for it." );
+
     while ( true ) {
 
         if ( _exit_flag.load( ) == 1 ) break;
 
+        const auto tick_start = service_reactor_t::clock::now( );
+
+        begin_status_pass( );
 
         auto now = std::chrono::system_clock::now();
         std::time_t now_time = std::chrono::system_clock::to_time_t(now);
 
-        for ( const auto& service : _services ) {
-
-            // Check if the service requires a workday
-            if ( service->required_workday ) {
-
-                // If it's not a working day
-                if ( !_is_working_day ) {
-
-                    // Check if the service is currently active
-                    if (service->state == service_state::ACTIVE) {
-                        
-                        // If the service is still active according to its status, stop the service
-                        if ( get_service_status( *service ) == service_state::ACTIVE ) {
-                            stop_service( *service );
-                        } else {
-                            // Force close request if the service is not active
-                            _logger->info( "Initiate \"", service->service_name, "\" force close (1)" );
-                            stop_service( *service );
-                        }
-                    }
-
-                    // Skip the rest of the loop and move to the next service (if applicable)
-                    continue;
-                }
-            }
+        // Apply the results of actions finished meanwhile and resume the cascades waiting on them
+        drain_actions( );
+        _executor.run( );
 
-            // Check if the service supports restart functionality
-            if ( service->is_restart_support ) {
-
-                // If the service has not been restarted yet
-                if ( !service->is_restarted ) {
-
-                    // Check if the service needs a restart based on the current time
-                    if ( service->time_range->need_restart( now_time ) ) {
-
-                        // Stop all dependent services before restarting this service
-                        if( service->has_dependent_service && toggel_dependent_service( service->service_name, service->dependent, now_time, true ) > 0 ) {
-                            
-                            // Give the dependent service a chance to stop completely before continuing.
-                            // If `wait_for(10000)` returns 0, it indicates a timeout or successful stop,
-                            // so we break the loop to avoid further processing.
-                            if ( wait_for( 10000 ) == 0 ) {
-                                break;
-                            }
-                        }
-
-                        // Restart the service if needed
-                        restart_service( *service );
-                        // Mark the service as restarted to prevent redundant restarts
-                        service->is_restarted = true;
-                        // Give the service a chance to restart completely before continuing.
-                        // If `wait_for(10000)` returns 0, it indicates a timeout or successful stop,
-                        // so we break the loop to avoid further processing.
-                        if ( wait_for( 10000 ) == 0 ) {
-                            break;
-                        }
-
-                        // Start all dependent services again after the restart
-                        if ( service->has_dependent_service && toggel_dependent_service( service->service_name, service->dependent, now_time, false ) > 0 ) {
-
-                            // Give the dependent service a chance to start completely before continuing.
-                            // If `wait_for(10000)` returns 0, it indicates a timeout or successful stop,
-                            // so we break the loop to avoid further processing.
-                            if ( wait_for( 10000 ) == 0 ) {
-                                break;
-                            }
-                        }
-
-                        // Skip to the next iteration
-                        continue;
-                    }
-                }
+        // Completion of the background day switch or clean
+        _pipeline.drain( );
+
+        if ( _day_pipeline_deferred && !_pipeline.is_running( ) ) {
+            start_day_pipeline( );
+        }
+
+        if ( _day_switch_failed ) {
+            status = 0;
+            break;
+        }
+
+        // Fire every due boundary exactly once; boundaries missed while busy are caught up here
+        schedule_entry entry;
+
+        while ( _scheduler.pop_due( now_time, entry ) == 1 ) {
+            if ( entry.event == schedule_event::RESTART ) {
+                restart_due[entry.service_index] = 1;
             }
+        }
 
-            // Check if the service is within its active time range
-            if ( service->time_range->is_between_times( now_time ) ) {
+        // The actions of this pass are handed to the workers together, as pipelined batches
+        _workers->hold( );
 
-                // If the service is currently inactive
-                if ( get_service_status( *service ) == service_state::INACTIVE ) {
-                    // This means the service failed or is not running; we need to restart it
-                    _logger->info( "\"", service->service_name, "\" status inactive. We've to start." );
+        for ( size_t i = 0; i < _services.size( ); i++ ) {
 
-                    // Start the service
-                    start_service( *service );
-                }
+            const svc_schedule& schedule = _services.get_schedule( i );
+
+            // Decided again once its action or cascade finished, a due restart is kept until then
+            if ( schedule.pending_actions > 0 || schedule.cascades > 0 ) continue;
+
+            process_service( i, now_time, restart_due[i] != 0 );
+
+            restart_due[i] = 0;
+        }
+
+        // Start the cascades spawned in this pass
+        _executor.run( );
 
-                // Skip the rest of the loop and move to the next service (if applicable)
+        _workers->release( );
+
+        // Indexes change on reload, so it waits until no action or cascade refers to them
+        if ( _reload_requested && is_idle( ) ) {
+
+            _reload_requested = false;
+
+            if ( reload_config( ) == 1 ) {
+                _state_dirty = true;
+                // Nothing was pending, so no popped restart is outstanding
+                restart_due.assign( _services.size( ), 0 );
+                // Evaluate the new configuration right away
                 continue;
             }
+        }
 
-            // If the service is active
-            if ( service->state == service_state::ACTIVE ) {
+        // One write for all transitions of this pass
+        persist_service_state( );
 
-                // Check if the service is still active based on its current status
-                if ( get_service_status( *service ) == service_state::ACTIVE ) {
-                    // Stop the active service
-                    stop_service( *service );
-                } else {
-                    // Force close the service if it’s not active, and log the request
-                    _logger->info( "Initiate \"", service->service_name, "\" force close (2)" );
-                    stop_service( *service );
-                }
-            }
+        // Sleep until the next schedule boundary, sweep or midnight,
+        // or less if a service changed its state
+        std::time_t wake_epoch = _get_next_midnight( now_time );
 
+        if ( !_scheduler.empty( ) && _scheduler.next_epoch( ) < wake_epoch ) {
+            wake_epoch = _scheduler.next_epoch( );
         }
 
-        // Sleep for 30 seconds before checking again
-        if ( wait_for( delay_ms ) == 0 ) {
+        // Wall-clock only maps the boundary onto the monotonic clock; the sweep caps
+        // the wait, so a wall-clock jump is re-mapped within one sweep interval
+        auto deadline = service_reactor_t::clock::now( ) + std::chrono::duration_cast<service_reactor_t::clock::duration>(
+            std::chrono::system_clock::from_time_t( wake_epoch ) - std::chrono::system_clock::now( )
+        );
+
+        const auto wait_deadline = std::min( { deadline, next_sweep, _executor.next_deadline( ) } );
+
+        const auto work_time = service_reactor_t::clock::now( ) - tick_start;
+
+        tick_duration.observe( work_time );
+        _tick_duration.record( work_time );
+
+        if ( wait_for_event( wait_deadline ) == 0 ) {
             break;
         }
-        
-        if ( switch_to_new_day( ) == 0 ) {
-            return 0;
+
+        // Only a wake-up by the deadline lags; an event wakes the loop early
+        const auto woke = service_reactor_t::clock::now( );
+
+        if ( woke >= wait_deadline ) {
+            tick_lag.observe( woke - wait_deadline );
+            _tick_lag.record( woke - wait_deadline );
         }
 
+        if ( service_reactor_t::clock::now( ) >= next_sweep ) {
+            next_sweep = service_reactor_t::clock::now( ) + sweep_interval;
+            sync_service_state( );
+        }
+        
+        switch_to_new_day( );
+
         _logger->flush( );
     }
     
+    // Cascades still in flight are abandoned, their queued actions are dropped with the pool
+    _executor.clear( );
+
+    // A stage in progress is interrupted, it must not outlive the loop
+    _pipeline.stop( );
+
     _logger->info( "\"Service manager\" thread exited." );
 
-    return 1;
+    return status;
 }
 
-int service_handler_t::switch_to_new_day() {
+void service_handler_t::switch_to_new_day() {
 
     std::string current_date;
 
@@ -684,53 +1722,114 @@ int service_handler_t::switch_to_new_day() {
 
     // Check if the date has changed
     if (current_date != _last_date) {
+        // Close the day's loop statistics in the day's own log
+        _logger->info( "Tick lag (us) count p50 p90 p99 p99.9 max: ", _tick_lag.summary( ) );
+        _logger->info( "Tick duration (us) count p50 p90 p99 p99.9 max: ", _tick_duration.summary( ) );
+        _tick_lag.reset( );
+        _tick_duration.reset( );
+
         // Update the last recorded date
         _last_date = current_date;
 
         // Renew the logger to reflect the new day's logs
         _logger->renew( );
 
-#ifdef USE_HTTP_DAY_STATUS
-        // Load the new day's status from an external base server
-        if (load_day_status( ) == 0) {
+        // The day's status and the dust clean follow in the background
+        start_day_pipeline( );
 
-            // Log an error if the day status failed to load
-            _logger->error( "Failed to load day status for ", _last_date );
-            _logger->flush( );
-
-            return 0; // Return failure
-        }
-#endif //!USE_HTTP_DAY_STATUS
-
-        // Clean up any leftover service log if the cleaner (service log) is not empty
-        if ( !_cleaner->is_empty( ) ) {
-            _cleaner->clean( _logger );
-        }
+        std::vector<service_state> states;
+        query_service_states( states );
 
         // Prepare the time ranges for all registered services
-        for ( const auto& service : _services ) {
+        for ( size_t i = 0; i < _services.size( ); i++ ) {
+
+            const svc_config& service = _services.get_config( i );
+            svc_schedule& schedule = _services.get_schedule( i );
 
-            _logger->debug( "Prepare service : \"", service->service_name, "\"" );
+            _logger->debug( "Prepare service : \"", service.service_name, "\"" );
 
-            service->time_range->prepare( );
-            service->time_range->print( _logger );
-            service->is_restarted = false;
+            schedule.time_range.prepare( );
+            schedule.time_range.print( _logger );
+            schedule.is_restarted = false;
 
-            if ( get_service_status( *service ) == service_state::ACTIVE ) {
+            if ( states[i] == service_state::ACTIVE ) {
                 
-                service->state = service_state::ACTIVE;
-                _logger->debug( "\"", service->service_name, "\" Service status : Active" );
+                // Came up meanwhile, it is no longer parked
+                schedule.state = service_state::ACTIVE;
+                schedule.retry_epoch = 0;
+                _logger->debug( "\"", service.service_name, "\" Service status : Active" );
+
+            } else if ( schedule.retry_epoch != 0 ) {
+
+                schedule.state = service_state::FAILED_BACKOFF;
+                _logger->debug( "\"", service.service_name, "\" Service status : Backoff" );
 
             } else {
 
-                service->state = service_state::INACTIVE;
-                _logger->debug( "\"", service->service_name, "\" Service status : Inactive" );
+                schedule.state = service_state::INACTIVE;
+                _logger->debug( "\"", service.service_name, "\" Service status : Inactive" );
 
             }
         }
+
+        // Today's boundaries replace the ones of the previous day
+        rebuild_schedule( std::chrono::system_clock::to_time_t( std::chrono::system_clock::now( ) ) );
+
+        _state_dirty = true;
     }
+}
+
+void service_handler_t::start_day_pipeline( ) {
+
+    std::vector<std::pair<std::string, background_pipeline_t::stage>> stages;
+
+#ifdef USE_HTTP_DAY_STATUS
+    // Load the new day's status from an external base server
+    stages.emplace_back( "trade-date", [this, date = _last_date]( ) {
+
+        int status = load_day_status( date, [this]( long ms ) { return _pipeline.sleep_for( ms ); } );
+
+        // Services requiring a workday are evaluated again right away
+        _day_status_pending = false;
+        _reactor.wake( );
+
+        return status;
+    });
+#endif //!USE_HTTP_DAY_STATUS
+
+    // Clean up any leftover service log if the cleaner (service log) is not empty
+    if ( !_cleaner->is_empty( ) ) {
+        stages.emplace_back( "dust-clean", [this]( ) {
+            _cleaner->clean( _logger );
+            return 1;
+        });
+    }
+
+    if ( stages.empty( ) ) return;
+
+    _day_status_pending = stages.front( ).first == "trade-date";
+
+    auto started = service_reactor_t::clock::now( );
+
+    int status = _pipeline.start( std::move( stages ), [this, started]( int status, const std::string& failed_stage ) {
+
+        if ( status == 0 ) {
+            // Log an error if the day status failed to load
+            _logger->error( "Failed to load day status for ", _last_date, "; Stage: ", failed_stage );
+            _logger->flush( );
+            _day_switch_failed = true;
+            return;
+        }
 
-    return 1; // Return success
+        _logger->info( "Day switch stages done in ", std::chrono::duration_cast<std::chrono::milliseconds>( service_reactor_t::clock::now( ) - started ).count( ), " ms" );
+    });
+
+    // Tried again once the running stages (e.g. a clean) were drained; workday services wait until then
+    _day_pipeline_deferred = status == 0;
+
+    if ( status == 0 ) {
+        _logger->info( "Previous background stages still running; day switch stages of ", _last_date, " queued behind them" );
+    }
 }
 
 void service_handler_t::exit( ) {
@@ -739,6 +1838,6 @@ void service_handler_t::exit( ) {
 
     _exit_flag.store( 1 );
 
-    _promise->set_value( );
+    _reactor.stop( );
 }
 
@@ -0,0 +1,156 @@
+/*
+* Copyright FSys Tech Limited [FSys]. All rights reserved.
+*
+* This software owned by FSys Tech Limited [FSys] and is protected by copyright law
+* and international copyright treaties.
+*
+* Access to and use of the software is governed by the terms of the applicable FSys Software
+* Services Agreement (the Agreement) and Customer end user license agreements granting
+* a non-assignable, non-transferable and non-exclusive license to use the software
+* for it's own data processing purposes under the terms defined in the Agreement.
+*
+* Except as otherwise granted within the terms of the Agreement, copying or reproduction of any part
+* of this source code or associated reference material to any other location for further reproduction
+* or redistribution, and any amendments to this copyright notice, are expressly prohibited.
+*
+* Any reproduction or redistribution for sale or hiring of the Software not in accordance with
+* the terms of the Agreement is a violation of copyright law.
+*/
+// 4:45 PM 10/17/2026
+// by Rajib Chy
+
+#include <svc/histogram.h>
+#include <cmath>
+#include <bit>
+
+constexpr uint64_t MAX_VALUE = ( 1ull << latency_histogram_t::MAX_MAGNITUDE ) - 1;
+
+size_t _latency_bucket_index( uint64_t value ) {
+
+    constexpr uint64_t linear = 2 * latency_histogram_t::SUB_BUCKETS;
+
+    if ( value > MAX_VALUE ) value = MAX_VALUE;
+
+    if ( value < linear ) return static_cast<size_t>( value );
+
+    // The top SUB_BUCKET_BITS + 1 bits select the bucket within the power of two
+    int magnitude = std::bit_width( value ) - 1;
+    int shift = magnitude - latency_histogram_t::SUB_BUCKET_BITS;
+    uint64_t sub = ( value >> shift ) - latency_histogram_t::SUB_BUCKETS;
+
+    return static_cast<size_t>( linear + static_cast<uint64_t>( magnitude - latency_histogram_t::SUB_BUCKET_BITS - 1 ) * latency_histogram_t::SUB_BUCKETS + sub );
+}
+
+uint64_t _latency_bucket_highest( size_t index ) {
+
+    constexpr uint64_t linear = 2 * latency_histogram_t::SUB_BUCKETS;
+
+    if ( index < linear ) return index;
+
+    uint64_t offset = index - linear;
+    int shift = static_cast<int>( offset / latency_histogram_t::SUB_BUCKETS ) + 1;
+    uint64_t sub = offset % latency_histogram_t::SUB_BUCKETS + latency_histogram_t::SUB_BUCKETS;
+
+    return ( ( sub + 1 ) << shift ) - 1;
+}
+
+void latency_histogram_t::record( duration value ) {
+
+    int64_t us = std::chrono::duration_cast<std::chrono::microseconds>( value ).count( );
+    uint64_t clamped = us < 0 ? 0 : static_cast<uint64_t>( us );
+
+    if ( clamped > MAX_VALUE ) clamped = MAX_VALUE;
+
+    _counts[_latency_bucket_index( clamped )].fetch_add( 1, std::memory_order_relaxed );
+    _total.fetch_add( 1, std::memory_order_relaxed );
+
+    uint64_t current = _max.load( std::memory_order_relaxed );
+
+    while ( clamped > current && !_max.compare_exchange_weak( current, clamped, std::memory_order_relaxed ) ) { }
+}
+
+uint64_t latency_histogram_t::count( ) const {
+    return _total.load( std::memory_order_relaxed );
+}
+
+uint64_t latency_histogram_t::max( ) const {
+    return _max.load( std::memory_order_relaxed );
+}
+
+// Walks a copy of the counts, so concurrent recording cannot skew one walk
+static void _snapshot( const std::atomic<uint64_t>* counts, uint64_t* copy, uint64_t& total ) {
+
+    total = 0;
+
+    for ( size_t i = 0; i < latency_histogram_t::BUCKETS; i++ ) {
+        copy[i] = counts[i].load( std::memory_order_relaxed );
+        total += copy[i];
+    }
+}
+
+static uint64_t _percentile_of( const uint64_t* counts, uint64_t total, uint64_t max, double percentile ) {
+
+    if ( total == 0 ) return 0;
+
+    if ( percentile < 0 ) percentile = 0;
+    if ( percentile > 100 ) percentile = 100;
+
+    uint64_t target = static_cast<uint64_t>( std::ceil( percentile / 100.0 * static_cast<double>( total ) ) );
+
+    if ( target == 0 ) target = 1;
+
+    uint64_t cumulative = 0;
+
+    for ( size_t i = 0; i < latency_histogram_t::BUCKETS; i++ ) {
+
+        cumulative += counts[i];
+
+        if ( cumulative >= target ) {
+            uint64_t highest = _latency_bucket_highest( i );
+            // The bucket may be wider than anything actually recorded
+            return highest < max ? highest : max;
+        }
+    }
+
+    return max;
+}
+
+uint64_t latency_histogram_t::percentile( double percentile ) const {
+
+    uint64_t counts[BUCKETS];
+    uint64_t total;
+
+    _snapshot( _counts, counts, total );
+
+    return _percentile_of( counts, total, max( ), percentile );
+}
+
+std::string latency_histogram_t::summary( ) const {
+
+    uint64_t counts[BUCKETS];
+    uint64_t total;
+
+    _snapshot( _counts, counts, total );
+
+    uint64_t largest = max( );
+
+    std::string out( std::to_string( total ) );
+
+    for ( double percentile : { 50.0, 90.0, 99.0, 99.9 } ) {
+        out.append( " " ).append( std::to_string( _percentile_of( counts, total, largest, percentile ) ) );
+    }
+
+    out.append( " " ).append( std::to_string( largest ) );
+
+    return out;
+}
+
+void latency_histogram_t::reset( ) {
+
+    for ( auto& count : _counts ) {
+        count.store( 0, std::memory_order_relaxed );
+    }
+
+    _total.store( 0, std::memory_order_relaxed );
+    _max.store( 0, std::memory_order_relaxed );
+}
@@ -0,0 +1,111 @@
+/*
+* Copyright FSys Tech Limited [FSys]. All rights reserved.
+*
+* This software owned by FSys Tech Limited [FSys] and is protected by copyright law
+* and international copyright treaties.
+*
+* Access to and use of the software is governed by the terms of the applicable FSys Software
+* Services Agreement (the Agreement) and Customer end user license agreements granting
+* a non-assignable, non-transferable and non-exclusive license to use the software
+* for it's own data processing purposes under the terms defined in the Agreement.
+*
+* Except as otherwise granted within the terms of the Agreement, copying or reproduction of any part
+* of this source code or associated reference material to any other location for further reproduction
+* or redistribution, and any amendments to this copyright notice, are expressly prohibited.
+*
+* Any reproduction or redistribution for sale or hiring of the Software not in accordance with
+* the terms of the Agreement is a violation of copyright law.
+*/
+// 9:12 AM 10/16/2026
+// by Rajib Chy
+
+#include <svc/job.h>
+#include <chrono>
+
+service_job_t::service_job_t( const std::string& job_path ) : _path( job_path ) { }
+
+const std::string& service_job_t::get_path( ) const {
+    return _path;
+}
+
+bool service_job_t::is_done( ) const {
+    std::lock_guard<std::mutex> lock( _mutex );
+    return _result != job_result::PENDING;
+}
+
+job_result service_job_t::get_result( ) const {
+    std::lock_guard<std::mutex> lock( _mutex );
+    return _result;
+}
+
+job_result service_job_t::wait( long ms ) {
+
+    std::unique_lock<std::mutex> lock( _mutex );
+
+    _cv.wait_for( lock, std::chrono::milliseconds( ms ), [this]( ) {
+        return _result != job_result::PENDING;
+    });
+
+    return _result;
+}
+
+void service_job_t::on_complete( std::function<void( job_result )> callback ) {
+
+    job_result result;
+
+    {
+        std::lock_guard<std::mutex> lock( _mutex );
+
+        if ( _result == job_result::PENDING ) {
+            _callbacks.push_back( std::move( callback ) );
+            return;
+        }
+
+        result = _result;
+    }
+
+    callback( result );
+}
+
+void service_job_t::complete( job_result result ) {
+
+    std::vector<std::function<void( job_result )>> callbacks;
+
+    {
+        std::lock_guard<std::mutex> lock( _mutex );
+
+        if ( _result != job_result::PENDING ) return;
+
+        _result = result;
+        callbacks.swap( _callbacks );
+    }
+
+    _cv.notify_all( );
+
+    // Invoke outside the lock, callbacks may query the job again
+    for ( const auto& callback : callbacks ) {
+        callback( result );
+    }
+}
+
+job_result _to_job_result( const std::string& result ) {
+    if ( result == "done" ) return job_result::DONE;
+    if ( result == "canceled" ) return job_result::CANCELED;
+    if ( result == "timeout" ) return job_result::TIMEOUT;
+    if ( result == "dependency" ) return job_result::DEPENDENCY;
+    if ( result == "skipped" ) return job_result::SKIPPED;
+    return job_result::FAILED;
+}
+
+const char* _job_result_name( job_result result ) {
+    switch ( result ) {
+        case job_result::PENDING: return "pending";
+        case job_result::DONE: return "done";
+        case job_result::CANCELED: return "canceled";
+        case job_result::TIMEOUT: return "timeout";
+        case job_result::DEPENDENCY: return "dependency";
+        case job_result::SKIPPED: return "skipped";
+        case job_result::FAILED:
+        default: return "failed";
+    }
+}
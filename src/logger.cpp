@@ -159,6 +159,8 @@ void svc_logger::_write_intro( bool is_exists ) {
 }
 
 int svc_logger::open( ) {
+
+	std::lock_guard<std::recursive_mutex> lock( _mutex );
 	
 	_out = std::make_shared<std::ofstream>( );
 	std::string l_path( "./svcm/log/" );
@@ -179,7 +181,9 @@ int svc_logger::open( ) {
 }
 
 void svc_logger::renew() {
-	
+
+    std::lock_guard<std::recursive_mutex> lock( _mutex );
+
     // Log the start of the logger switching process
     write(SVC_LOGGER_INFO, "Logger Switching\n");
     
@@ -201,6 +205,8 @@ void svc_logger::renew() {
 
 
 void svc_logger::flush( ) {
+
+	std::lock_guard<std::recursive_mutex> lock( _mutex );
 	
 	if ( _need_flush < 1 )return;
 	
@@ -213,6 +219,8 @@ void svc_logger::flush( ) {
 }
 
 void svc_logger::close( ) {
+
+	std::lock_guard<std::recursive_mutex> lock( _mutex );
 	
 	_need_flush = 0;
 	
@@ -225,6 +233,8 @@ void svc_logger::close( ) {
 	
 void svc_logger::write( int log_label, const std::string& message ) {
 
+	std::lock_guard<std::recursive_mutex> lock( _mutex );
+
 	if ( _need_flush == 0 ) {
 		_need_flush++;
 	}
@@ -20,72 +20,470 @@
 // by Rajib Chy
 
 #include <svc/manager.h>
+#include <svc/metrics.h>
+#include <algorithm>
+#include <iterator>
+#include <future>
+#include <chrono>
 
 constexpr const char REPLACE[] = "replace";
 constexpr const char GETUNIT[] = "GetUnit";
 constexpr const char LOADUNIT[] = "LoadUnit";
+constexpr const char LIST_UNITS_BY_NAMES[] = "ListUnitsByNames";
 constexpr const char STOP_UNIT[] = "StopUnit";
 constexpr const char SERVICE_EXT[] = ".service";
 constexpr const char START_UNIT[] = "StartUnit";
+constexpr const char SUBSCRIBE[] = "Subscribe";
+constexpr const char UNIT_NEW[] = "UnitNew";
+constexpr const char JOB_REMOVED[] = "JobRemoved";
+constexpr const char RELOADING[] = "Reloading";
+constexpr const char UNIT_REMOVED[] = "UnitRemoved";
+constexpr const char SUB_STATE[] = "SubState";
 constexpr const char ACTIVE_STATE[] = "ActiveState";
+constexpr const char GET_PROPERTY[] = "Get";
+constexpr const char GET_ALL_PROPERTIES[] = "GetAll";
+constexpr const char MAIN_PID[] = "MainPID";
+constexpr const char N_RESTARTS[] = "NRestarts";
+constexpr const char EXEC_MAIN_STATUS[] = "ExecMainStatus";
+constexpr const char ACTIVE_ENTER_TIMESTAMP[] = "ActiveEnterTimestamp";
+constexpr const char INACTIVE_EXIT_TIMESTAMP[] = "InactiveExitTimestamp";
+constexpr const char PROPERTIES_CHANGED[] = "PropertiesChanged";
+constexpr const char ORG_FREEDESKTOP_DBUS_PROPERTIES[] = "org.freedesktop.DBus.Properties";
 constexpr const char RESTART_UNIT[] = "RestartUnit";
+constexpr const char RESET_FAILED_UNIT[] = "ResetFailedUnit";
 constexpr const char ORG_FREEDESKTOP_SYSTEMD[] = "org.freedesktop.systemd1";
 constexpr const char ORG_FREEDESKTOP_SYSTEMD_PATH[] = "/org/freedesktop/systemd1";
 constexpr const char ORG_FREEDESKTOP_SYSTEMD_UNIT[] = "org.freedesktop.systemd1.Unit";
+constexpr const char ORG_FREEDESKTOP_SYSTEMD_SERVICE[] = "org.freedesktop.systemd1.Service";
 constexpr const char ORG_FREEDESKTOP_SYSTEMD_MANAGER[] = "org.freedesktop.systemd1.Manager";
 
-service_manager_t::service_manager_t( ) {
-    // Create the D-Bus system bus connection only once when the object is created
-    _connection = sdbus::createSystemBusConnection( );
+// GetAll with an empty interface name returns the properties of every interface (Unit and Service)
+constexpr const char ALL_INTERFACES[] = "";
+
+// Upper bound of cached unit proxies; large enough for the managed services and their dependents
+constexpr size_t MAX_UNIT_PROXY = 64;
+
+// Upper bound of remembered JobRemoved signals that raced ahead of their method reply
+constexpr size_t MAX_FINISHED_JOB = 128;
+
+// Manager method queuing the job of an operation
+static const char* _unit_operation_method( unit_operation operation ) {
+    switch ( operation ) {
+        case unit_operation::STOP: return STOP_UNIT;
+        case unit_operation::RESTART: return RESTART_UNIT;
+        case unit_operation::START:
+        default: return START_UNIT;
+    }
+}
+
+// Latency histogram of one D-Bus method; callers keep the reference
+static metric_histogram_t& _dbus_latency( const std::string& method ) {
+    return _metrics( ).histogram(
+        "svcm_dbus_call_duration_seconds", "Latency of D-Bus method calls to systemd.", _metric_label( "method", method )
+    );
+}
+
+// Looks up a property in a GetAll reply or PropertiesChanged signal
+template<typename Map>
+static const sdbus::Variant* _find_property( const Map& properties, const char* name ) {
+    auto it = properties.find( typename Map::key_type( name ) );
+    return it == properties.end( ) ? nullptr : &it->second;
+}
+
+// Applies the properties present in the map; the strings are parsed here, once per reply or signal
+template<typename Map>
+static void _read_unit_properties( const Map& properties, unit_status& status ) {
+
+    if ( const sdbus::Variant* value = _find_property( properties, ACTIVE_STATE ) ) {
+        status.active_state = _to_unit_active_state( value->get<std::string>( ) );
+    }
+    if ( const sdbus::Variant* value = _find_property( properties, SUB_STATE ) ) {
+        status.sub_state = _to_unit_sub_state( value->get<std::string>( ) );
+    }
+    if ( const sdbus::Variant* value = _find_property( properties, MAIN_PID ) ) {
+        status.main_pid = value->get<uint32_t>( );
+    }
+    if ( const sdbus::Variant* value = _find_property( properties, N_RESTARTS ) ) {
+        status.restarts = value->get<uint32_t>( );
+    }
+    if ( const sdbus::Variant* value = _find_property( properties, ACTIVE_ENTER_TIMESTAMP ) ) {
+        status.active_enter_timestamp = value->get<uint64_t>( );
+    }
+    if ( const sdbus::Variant* value = _find_property( properties, INACTIVE_EXIT_TIMESTAMP ) ) {
+        status.inactive_exit_timestamp = value->get<uint64_t>( );
+    }
+    if ( const sdbus::Variant* value = _find_property( properties, EXEC_MAIN_STATUS ) ) {
+        status.exec_main_status = value->get<int32_t>( );
+    }
+}
+
+service_manager_t::service_manager_t( bool external_loop ) : service_manager_t( std::string( ), external_loop ) {
+}
+
+service_manager_t::service_manager_t( const std::string& bus_address, bool external_loop ) : _external_loop( external_loop ) {
+    // Create the D-Bus connection only once when the object is created
+    if ( bus_address.empty( ) ) {
+        _connection = sdbus::createSystemBusConnection( );
+    } else {
+        _connection = sdbus::createSessionBusConnectionWithAddress( bus_address );
+    }
+    // The systemd manager object never changes, so keep a single proxy for the whole lifetime
+    _manager_proxy = sdbus::createProxy(
+        *_connection, sdbus::ServiceName( ORG_FREEDESKTOP_SYSTEMD ), sdbus::ObjectPath( ORG_FREEDESKTOP_SYSTEMD_PATH )
+    );
+
+    subscribe_unit_signals( );
+
+    // Dispatch incoming signals on a background thread, unless the owner polls the connection
+    if ( !_external_loop ) {
+        _connection->enterEventLoopAsync( );
+    }
+}
+
+service_manager_t::~service_manager_t( ) {
+    if ( !_external_loop ) {
+        _connection->leaveEventLoop( );
+    }
+    // Release the watch proxies before the connection goes away
+    _unit_states.clear( );
+}
+
+backend_poll_data service_manager_t::get_poll_data( ) const {
+
+    sdbus::IConnection::PollData poll_data = _connection->getEventLoopPollData( );
+
+    backend_poll_data result;
+    result.fd = poll_data.fd;
+    result.events = poll_data.events;
+    result.timeout = poll_data.getPollTimeout( );
+    result.event_fd = poll_data.eventFd;
+
+    return result;
+}
+
+int service_manager_t::process_pending( ) {
+
+    int count = 0;
+
+    while ( _connection->processPendingEvent( ) ) {
+        count++;
+    }
+
+    return count;
+}
+
+void service_manager_t::subscribe_unit_signals( ) {
+
+    _manager_proxy->uponSignal( UNIT_NEW )
+        .onInterface( ORG_FREEDESKTOP_SYSTEMD_MANAGER )
+        .call( [this]( const std::string& unit_id, const sdbus::ObjectPath& /*unit_path*/ ) {
+            forget_unit_path( unit_id );
+        });
+
+    _manager_proxy->uponSignal( UNIT_REMOVED )
+        .onInterface( ORG_FREEDESKTOP_SYSTEMD_MANAGER )
+        .call( [this]( const std::string& unit_id, const sdbus::ObjectPath& /*unit_path*/ ) {
+            forget_unit_path( unit_id );
+        });
+
+    _manager_proxy->uponSignal( JOB_REMOVED )
+        .onInterface( ORG_FREEDESKTOP_SYSTEMD_MANAGER )
+        .call( [this]( uint32_t /*id*/, const sdbus::ObjectPath& job_path, const std::string& /*unit*/, const std::string& result ) {
+            complete_job( job_path, result );
+        });
+
+    _manager_proxy->uponSignal( RELOADING )
+        .onInterface( ORG_FREEDESKTOP_SYSTEMD_MANAGER )
+        .call( [this]( bool /*active*/ ) {
+            std::lock_guard<std::mutex> lock( _unit_path_mutex );
+            _unit_paths.clear( );
+        });
+
+    try {
+        // systemd only emits unit signals to subscribed clients
+        metric_timer_t timer( _dbus_latency( SUBSCRIBE ) );
+        _manager_proxy->callMethod( SUBSCRIBE ).onInterface( ORG_FREEDESKTOP_SYSTEMD_MANAGER );
+    } catch ( const sdbus::Error& e ) {
+        // Without a subscription the cache is still dropped on D-Bus errors
+        set_last_error( "D-Bus error: ", e.what( ) );
+    }
+}
+
+void service_manager_t::forget_unit_path( const std::string& service_name ) {
+    std::lock_guard<std::mutex> lock( _unit_path_mutex );
+    _unit_paths.erase( service_name );
+}
+
+void service_manager_t::load_unit_path( const std::string& service_name, sdbus::ObjectPath& object_path ) {
+
+    {
+        std::lock_guard<std::mutex> lock( _unit_path_mutex );
+        auto it = _unit_paths.find( service_name );
+        if ( it != _unit_paths.end( ) ) {
+            object_path = it->second;
+            return;
+        }
+    }
+
+    // Use LoadUnit instead of GetUnit
+
+    // GetUnit only works for loaded units. If a service has never been started,
+    // or if it's explicitly stopped and garbage-collected, systemd removes it from memory.
+    {
+        static metric_histogram_t& latency = _dbus_latency( LOADUNIT );
+        metric_timer_t timer( latency );
+
+        _manager_proxy->callMethod( LOADUNIT )
+            .onInterface( ORG_FREEDESKTOP_SYSTEMD_MANAGER )
+            .withArguments( service_name )
+            .storeResultsTo( object_path ); // The ObjectPath type will work here
+    }
+
+    std::lock_guard<std::mutex> lock( _unit_path_mutex );
+    _unit_paths[service_name] = object_path;
+}
+
+sdbus::IProxy& service_manager_t::get_unit_proxy( const sdbus::ObjectPath& object_path ) {
+
+    auto it = _unit_proxy_index.find( object_path );
+
+    if ( it != _unit_proxy_index.end( ) ) {
+        // Move the entry to the front, it is now the most recently used one
+        _unit_proxies.splice( _unit_proxies.begin( ), _unit_proxies, it->second );
+        return *it->second->second;
+    }
+
+    _unit_proxies.emplace_front(
+        object_path, sdbus::createProxy( *_connection, sdbus::ServiceName( ORG_FREEDESKTOP_SYSTEMD ), object_path )
+    );
+    _unit_proxy_index[object_path] = _unit_proxies.begin( );
+
+    if ( _unit_proxies.size( ) > MAX_UNIT_PROXY ) {
+        // Release the least recently used proxy
+        _unit_proxy_index.erase( _unit_proxies.back( ).first );
+        _unit_proxies.pop_back( );
+    }
+
+    return *_unit_proxies.front( ).second;
 }
 
 // Start a service
 int service_manager_t::start( const std::string& service_name ) {
-    return call_systemd_method( START_UNIT, service_name, REPLACE );
+    std::shared_ptr<service_job_t> job;
+    return call_systemd_method( START_UNIT, service_name, REPLACE, job );
+}
+
+int service_manager_t::start( const std::string& service_name, std::shared_ptr<service_job_t>& job ) {
+    return call_systemd_method( START_UNIT, service_name, REPLACE, job );
 }
 
 // Stop a service
 int service_manager_t::stop( const std::string& service_name ) {
-    return call_systemd_method( STOP_UNIT, service_name, REPLACE );
+    std::shared_ptr<service_job_t> job;
+    return call_systemd_method( STOP_UNIT, service_name, REPLACE, job );
+}
+
+int service_manager_t::stop( const std::string& service_name, std::shared_ptr<service_job_t>& job ) {
+    return call_systemd_method( STOP_UNIT, service_name, REPLACE, job );
 }
 
 // Restart a service
 int service_manager_t::restart( const std::string& service_name ) {
-    return call_systemd_method( RESTART_UNIT, service_name, REPLACE );
+    std::shared_ptr<service_job_t> job;
+    return call_systemd_method( RESTART_UNIT, service_name, REPLACE, job );
+}
+
+int service_manager_t::restart( const std::string& service_name, std::shared_ptr<service_job_t>& job ) {
+    return call_systemd_method( RESTART_UNIT, service_name, REPLACE, job );
+}
+
+int service_manager_t::reset_failed( const std::string& service_name ) {
+
+    try {
+
+        static metric_histogram_t& latency = _dbus_latency( RESET_FAILED_UNIT );
+        metric_timer_t timer( latency );
+
+        _manager_proxy->callMethod( RESET_FAILED_UNIT )
+            .onInterface( ORG_FREEDESKTOP_SYSTEMD_MANAGER )
+            .withArguments( service_name );
+
+        return 1;
+
+    } catch ( const sdbus::Error& e ) {
+
+        set_last_error( "D-Bus error: ", e.what( ) );
+
+        return -1;
+    }
+}
+
+int service_manager_t::call_many( std::vector<unit_request>& requests ) {
+
+    int status = 1;
+
+    if ( _external_loop ) {
+        // The replies would only be dispatched once we return to the owner's loop
+        for ( auto& request : requests ) {
+            if ( request.reset_failed ) {
+                reset_failed( request.service_name );
+            }
+            request.status = call_systemd_method( _unit_operation_method( request.operation ), request.service_name, REPLACE, request.job );
+            if ( request.status < 0 ) {
+                request.error = _last_error;
+                status = -1;
+            }
+        }
+        return status;
+    }
+
+    using clock = std::chrono::steady_clock;
+
+    std::vector<std::future<sdbus::ObjectPath>> replies( requests.size( ) );
+    std::vector<std::future<void>> resets;
+    const std::string mode( REPLACE );
+    const auto sent = clock::now( );
+
+    // Send every call first; the connection writes them back-to-back
+    for ( size_t i = 0; i < requests.size( ); i++ ) {
+
+        unit_request& request = requests[i];
+
+        try {
+
+            // Queued ahead on the same connection, so systemd resets the unit before the operation
+            if ( request.reset_failed ) {
+                resets.push_back( _manager_proxy->callMethodAsync( RESET_FAILED_UNIT )
+                    .onInterface( ORG_FREEDESKTOP_SYSTEMD_MANAGER )
+                    .withArguments( request.service_name )
+                    .getResultAsFuture<>( ) );
+            }
+
+            replies[i] = _manager_proxy->callMethodAsync( _unit_operation_method( request.operation ) )
+                .onInterface( ORG_FREEDESKTOP_SYSTEMD_MANAGER )
+                .withArguments( request.service_name, mode )
+                .getResultAsFuture<sdbus::ObjectPath>( );
+
+        } catch ( const sdbus::Error& e ) {
+
+            set_last_error( "D-Bus error: ", e.what( ) );
+            request.status = -1;
+            request.error = _last_error;
+            status = -1;
+
+        }
+    }
+
+    // Then collect the replies, which arrive in about the same order
+    for ( size_t i = 0; i < requests.size( ); i++ ) {
+
+        unit_request& request = requests[i];
+
+        if ( !replies[i].valid( ) ) continue;
+
+        try {
+
+            sdbus::ObjectPath job_path = replies[i].get( );
+
+            // Includes the wait for earlier replies, an upper bound of this call's latency
+            _dbus_latency( _unit_operation_method( request.operation ) ).observe( clock::now( ) - sent );
+
+            request.job = track_job( job_path );
+            request.status = 1;
+
+        } catch ( const std::exception& e ) {
+
+            set_last_error( "D-Bus error: ", e.what( ) );
+            request.status = -1;
+            request.error = _last_error;
+            status = -1;
+
+        }
+    }
+
+    // Answered before the operations they precede; a unit that is not failed is left as is
+    for ( auto& reset : resets ) {
+        try {
+            reset.get( );
+        } catch ( const std::exception& ) { }
+    }
+
+    return status;
+}
+
+std::shared_ptr<service_job_t> service_manager_t::track_job( const sdbus::ObjectPath& job_path ) {
+
+    std::shared_ptr<service_job_t> job = std::make_shared<service_job_t>( job_path );
+    job_result result;
+
+    {
+        std::lock_guard<std::mutex> lock( _job_mutex );
+
+        auto it = std::find_if( _finished_jobs.begin( ), _finished_jobs.end( ), [&job_path]( const auto& entry ) {
+            return entry.first == job_path;
+        });
+
+        if ( it == _finished_jobs.end( ) ) {
+            _pending_jobs[job_path] = job;
+            return job;
+        }
+
+        // JobRemoved was dispatched before the method reply reached us
+        result = it->second;
+        _finished_jobs.erase( it );
+    }
+
+    job->complete( result );
+
+    return job;
+}
+
+void service_manager_t::complete_job( const sdbus::ObjectPath& job_path, const std::string& result ) {
+
+    std::shared_ptr<service_job_t> job;
+
+    {
+        std::lock_guard<std::mutex> lock( _job_mutex );
+
+        auto it = _pending_jobs.find( job_path );
+
+        if ( it == _pending_jobs.end( ) ) {
+            // Either not ours, or the method reply is still on its way
+            _finished_jobs.emplace_back( job_path, _to_job_result( result ) );
+            if ( _finished_jobs.size( ) > MAX_FINISHED_JOB ) {
+                _finished_jobs.pop_front( );
+            }
+            return;
+        }
+
+        job = std::move( it->second );
+        _pending_jobs.erase( it );
+    }
+
+    job->complete( _to_job_result( result ) );
 }
 
 // Get the status of a service
 int service_manager_t::get_status( const std::string& service_name, std::string& result ) {
 
     try {
-        // Get the systemd manager object
-        sdbus::ServiceName orgfsym = sdbus::ServiceName(ORG_FREEDESKTOP_SYSTEMD);
-        sdbus::ObjectPath orgfsympath = sdbus::ObjectPath(ORG_FREEDESKTOP_SYSTEMD_PATH);
-        std::unique_ptr<sdbus::IProxy> proxy = sdbus::createProxy(
-            *_connection, orgfsym, orgfsympath
-        );
-
         // Prepare a variable for the result
         sdbus::ObjectPath object_path;
 
-        // Call LoadUint and retrieve the object path
-        // Use LoadUnit instead of GetUnit
-        
-        // GetUnit only works for loaded units. If a service has never been started,
-        // or if it's explicitly stopped and garbage-collected, systemd removes it from memory.
-        proxy->callMethod( LOADUNIT )
-            .onInterface( ORG_FREEDESKTOP_SYSTEMD_MANAGER )
-            .withArguments( service_name )
-            .storeResultsTo( object_path ); // The ObjectPath type will work here
+        // Resolve the unit object path, LoadUnit is called only when it is not cached yet
+        load_unit_path( service_name, object_path );
 
-        // Use the retrieved object path for the next proxy
-        auto unitProxy = sdbus::createProxy(
-            *_connection, orgfsym, object_path
-        );
+        // Use the retrieved object path to look up the cached unit proxy
+        sdbus::IProxy& unitProxy = get_unit_proxy( object_path );
+
+        static metric_histogram_t& latency = _dbus_latency( GET_PROPERTY );
 
         // Retrieve the ActiveState property
-        sdbus::Variant activeStateVariant = unitProxy->getProperty( ACTIVE_STATE )
-            .onInterface( ORG_FREEDESKTOP_SYSTEMD_UNIT );
+        sdbus::Variant activeStateVariant;
+        {
+            metric_timer_t timer( latency );
+            activeStateVariant = unitProxy.getProperty( ACTIVE_STATE ).onInterface( ORG_FREEDESKTOP_SYSTEMD_UNIT );
+        }
 
         // Extract the ActiveState as a string
         result = activeStateVariant.get<std::string>( );
@@ -94,12 +492,21 @@ int service_manager_t::get_status( const std::string& service_name, std::string&
             result = "inactive";
         }
 
+        // Keep the state table consistent in case a change notification was missed
+        unit_active_state active_state = _to_unit_active_state( result );
+        set_unit_state( service_name, [active_state]( unit_status& entry ) {
+            entry.active_state = active_state;
+        });
+
         return 1; // Success
 
     } catch ( const sdbus::Error& e ) {
         
         result = "inactive";
 
+        // The cached object path may be stale, resolve it again on the next call
+        forget_unit_path( service_name );
+
         set_last_error( "D-Bus error: ", e.what( ) );
 
         return -1;
@@ -113,6 +520,247 @@ int service_manager_t::get_status( const std::string& service_name, std::string&
     }
 }
 
+// Get the typed status of a service
+int service_manager_t::get_status( const std::string& service_name, unit_status& status ) {
+
+    status = unit_status( );
+
+    try {
+
+        sdbus::ObjectPath object_path;
+        load_unit_path( service_name, object_path );
+
+        sdbus::IProxy& unitProxy = get_unit_proxy( object_path );
+
+        static metric_histogram_t& latency = _dbus_latency( GET_ALL_PROPERTIES );
+
+        // One round-trip for the Unit and Service properties
+        std::map<sdbus::PropertyName, sdbus::Variant> properties;
+        {
+            metric_timer_t timer( latency );
+            properties = unitProxy.getAllProperties( ).onInterface( ALL_INTERFACES );
+        }
+
+        _read_unit_properties( properties, status );
+
+        // Keep the state table consistent in case a change notification was missed
+        set_unit_state( service_name, [&status]( unit_status& entry ) {
+            entry = status;
+        });
+
+        return 1;
+
+    } catch ( const sdbus::Error& e ) {
+
+        status = unit_status( );
+
+        // The cached object path may be stale, resolve it again on the next call
+        forget_unit_path( service_name );
+
+        set_last_error( "D-Bus error: ", e.what( ) );
+
+        return -1;
+
+    } catch ( const std::exception& e ) {
+
+        status = unit_status( );
+
+        set_last_error( "Unexpected error: ", e.what( ) );
+
+        return -1;
+
+    }
+}
+
+// Get the status of several services at once
+int service_manager_t::get_status_many( const std::vector<std::string>& service_names, std::vector<unit_status>& results ) {
+
+    // name, description, load state, active state, sub state, followed, unit path, job id, job type, job path
+    using unit_info = sdbus::Struct<
+        std::string, std::string, std::string, std::string, std::string,
+        std::string, sdbus::ObjectPath, uint32_t, std::string, sdbus::ObjectPath
+    >;
+
+    results.assign( service_names.size( ), unit_status( ) );
+
+    if ( service_names.empty( ) ) return 1;
+
+    try {
+
+        std::vector<unit_info> units;
+
+        {
+            static metric_histogram_t& latency = _dbus_latency( LIST_UNITS_BY_NAMES );
+            metric_timer_t timer( latency );
+
+            _manager_proxy->callMethod( LIST_UNITS_BY_NAMES )
+                .onInterface( ORG_FREEDESKTOP_SYSTEMD_MANAGER )
+                .withArguments( service_names )
+                .storeResultsTo( units );
+        }
+
+        std::unordered_map<std::string, size_t> positions;
+        positions.reserve( service_names.size( ) );
+
+        for ( size_t i = 0; i < service_names.size( ); i++ ) {
+            positions.emplace( service_names[i], i );
+        }
+
+        for ( const auto& unit : units ) {
+
+            const std::string& name = std::get<0>( unit );
+            const std::string& active_state = std::get<3>( unit );
+            const std::string& sub_state = std::get<4>( unit );
+
+            auto it = positions.find( name );
+
+            if ( it == positions.end( ) ) continue;
+
+            unit_status& status = results[it->second];
+            status.active_state = _to_unit_active_state( active_state );
+            status.sub_state = _to_unit_sub_state( sub_state );
+
+            // Keep the state table consistent in case a change notification was missed
+            set_unit_state( name, [&status]( unit_status& entry ) {
+                entry.active_state = status.active_state;
+                entry.sub_state = status.sub_state;
+            });
+        }
+
+        return 1;
+
+    } catch ( const sdbus::Error& e ) {
+
+        set_last_error( "D-Bus error: ", e.what( ) );
+
+        return -1;
+
+    }
+}
+
+int service_manager_t::watch( const std::string& service_name ) {
+
+    try {
+
+        sdbus::ObjectPath object_path;
+        load_unit_path( service_name, object_path );
+
+        std::unique_ptr<sdbus::IProxy> proxy = sdbus::createProxy(
+            *_connection, sdbus::ServiceName( ORG_FREEDESKTOP_SYSTEMD ), object_path
+        );
+
+        proxy->uponSignal( PROPERTIES_CHANGED )
+            .onInterface( ORG_FREEDESKTOP_DBUS_PROPERTIES )
+            .call( [this, service_name](
+                const std::string& interface_name,
+                const std::map<std::string, sdbus::Variant>& changed,
+                const std::vector<std::string>& /*invalidated*/
+            ) {
+
+                if ( interface_name != ORG_FREEDESKTOP_SYSTEMD_UNIT &&
+                    interface_name != ORG_FREEDESKTOP_SYSTEMD_SERVICE ) return;
+
+                set_unit_state( service_name, [&changed]( unit_status& entry ) {
+                    _read_unit_properties( changed, entry );
+                });
+
+            });
+
+        static metric_histogram_t& latency = _dbus_latency( GET_ALL_PROPERTIES );
+
+        unit_state_entry entry;
+        {
+            metric_timer_t timer( latency );
+            _read_unit_properties( proxy->getAllProperties( ).onInterface( ALL_INTERFACES ), entry.status );
+        }
+        entry.proxy = std::move( proxy );
+
+        std::lock_guard<std::mutex> lock( _unit_state_mutex );
+        _unit_states[service_name] = std::move( entry );
+
+        return 1;
+
+    } catch ( const sdbus::Error& e ) {
+
+        forget_unit_path( service_name );
+
+        set_last_error( "D-Bus error: ", e.what( ) );
+
+        return -1;
+
+    }
+}
+
+int service_manager_t::unwatch( const std::string& service_name ) {
+
+    std::unique_ptr<sdbus::IProxy> proxy;
+
+    {
+        std::lock_guard<std::mutex> lock( _unit_state_mutex );
+
+        auto it = _unit_states.find( service_name );
+
+        if ( it == _unit_states.end( ) ) return 0;
+
+        proxy = std::move( it->second.proxy );
+        _unit_states.erase( it );
+    }
+
+    // Dropping the proxy unsubscribes; done outside the lock, a signal handler may be waiting for it
+    proxy.reset( );
+
+    return 1;
+}
+
+int service_manager_t::get_cached_status( const std::string& service_name, unit_status& status ) {
+
+    std::lock_guard<std::mutex> lock( _unit_state_mutex );
+
+    auto it = _unit_states.find( service_name );
+
+    if ( it == _unit_states.end( ) ) {
+        return 0;
+    }
+
+    status = it->second.status;
+
+    return 1;
+}
+
+void service_manager_t::set_state_listener( state_listener listener ) {
+    std::lock_guard<std::mutex> lock( _unit_state_mutex );
+    _state_listener = std::move( listener );
+}
+
+void service_manager_t::set_unit_state( const std::string& service_name, const std::function<void( unit_status& )>& update ) {
+
+    state_listener listener;
+    unit_active_state active_state;
+
+    {
+        std::lock_guard<std::mutex> lock( _unit_state_mutex );
+
+        auto it = _unit_states.find( service_name );
+
+        if ( it == _unit_states.end( ) ) return;
+
+        unit_status& status = it->second.status;
+        unit_active_state previous = status.active_state;
+
+        update( status );
+
+        if ( status.active_state == previous ) return;
+
+        active_state = status.active_state;
+        listener = _state_listener;
+    }
+
+    // Notify outside the lock, the listener may query the state table again
+    if ( listener ) {
+        listener( service_name, active_state );
+    }
+}
+
 const char* service_manager_t::get_last_error( ) {
     if ( _last_error.empty( ) ) {
         return nullptr;
@@ -125,20 +773,22 @@ void service_manager_t::set_last_error( const std::string& prefix, const std::st
 }
 
 // Helper to call StartUnit, StopUnit, or RestartUnit
-int service_manager_t::call_systemd_method( const std::string& method, const std::string& service_name, const std::string& mode ) {
+int service_manager_t::call_systemd_method( const std::string& method, const std::string& service_name, const std::string& mode, std::shared_ptr<service_job_t>& job ) {
 
     try {
-        sdbus::ServiceName orgfsym = sdbus::ServiceName(ORG_FREEDESKTOP_SYSTEMD);
-        sdbus::ObjectPath orgfsympath = sdbus::ObjectPath(ORG_FREEDESKTOP_SYSTEMD_PATH);
-        // Get the systemd manager object
-        std::unique_ptr<sdbus::IProxy> proxy = sdbus::createProxy(
-            *_connection, orgfsym, orgfsympath
-        );
+        sdbus::ObjectPath job_path;
 
-        // Call the specified method
-        proxy->callMethod( method )
-            .onInterface( ORG_FREEDESKTOP_SYSTEMD_MANAGER )
-            .withArguments( service_name, mode );
+        // Call the specified method on the shared systemd manager proxy
+        {
+            metric_timer_t timer( _dbus_latency( method ) );
+
+            _manager_proxy->callMethod( method )
+                .onInterface( ORG_FREEDESKTOP_SYSTEMD_MANAGER )
+                .withArguments( service_name, mode )
+                .storeResultsTo( job_path );
+        }
+
+        job = track_job( job_path );
 
         return 1;
 
@@ -156,4 +806,14 @@ void _normalized_service_name( std::string& service_name ) {
     if ( service_name.find( '.' ) == std::string::npos ) {
         service_name += SERVICE_EXT; // Append the required service extension (e.g., ".service")
     }
-}
\ No newline at end of file
+}
+
+std::unique_ptr<service_backend_t> _create_system_backend( bool external_loop ) {
+    return std::make_unique<service_manager_t>( external_loop );
+}
+
+service_backend_factory _create_bus_backend_factory( const std::string& bus_address ) {
+    return [bus_address]( bool external_loop ) -> std::unique_ptr<service_backend_t> {
+        return std::make_unique<service_manager_t>( bus_address, external_loop );
+    };
+}
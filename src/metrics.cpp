@@ -0,0 +1,402 @@
+/*
+* Copyright FSys Tech Limited [FSys]. All rights reserved.
+*
+* This software owned by FSys Tech Limited [FSys] and is protected by copyright law
+* and international copyright treaties.
+*
+* Access to and use of the software is governed by the terms of the applicable FSys Software
+* Services Agreement (the Agreement) and Customer end user license agreements granting
+* a non-assignable, non-transferable and non-exclusive license to use the software
+* for it's own data processing purposes under the terms defined in the Agreement.
+*
+* Except as otherwise granted within the terms of the Agreement, copying or reproduction of any part
+* of this source code or associated reference material to any other location for further reproduction
+* or redistribution, and any amendments to this copyright notice, are expressly prohibited.
+*
+* Any reproduction or redistribution for sale or hiring of the Software not in accordance with
+* the terms of the Agreement is a violation of copyright law.
+*/
+// 2:10 PM 10/17/2026
+// by Rajib Chy
+
+#include <svc/metrics.h>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <unistd.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+
+// Upper bounds of the histogram buckets, in nanoseconds and as rendered in `le`
+static constexpr int64_t BUCKET_BOUNDS_NS[metric_histogram_t::BUCKETS] = {
+    100000, 500000, 1000000, 5000000, 10000000, 50000000,
+    100000000, 500000000, 1000000000, 5000000000, 10000000000
+};
+
+static constexpr const char* BUCKET_LABELS[metric_histogram_t::BUCKETS] = {
+    "0.0001", "0.0005", "0.001", "0.005", "0.01", "0.05", "0.1", "0.5", "1", "5", "10"
+};
+
+// A scraper sending a longer request header is disconnected
+constexpr size_t MAX_REQUEST_LENGTH = 8192;
+// Further scrapers are refused until one disconnects
+constexpr size_t MAX_CONNECTIONS = 8;
+
+void metric_counter_t::add( uint64_t value ) {
+    _value.fetch_add( value, std::memory_order_relaxed );
+}
+
+uint64_t metric_counter_t::get( ) const {
+    return _value.load( std::memory_order_relaxed );
+}
+
+void metric_histogram_t::observe( duration value ) {
+
+    int64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>( value ).count( );
+
+    if ( ns < 0 ) ns = 0;
+
+    size_t bucket = 0;
+
+    while ( bucket < BUCKETS && ns > BUCKET_BOUNDS_NS[bucket] ) {
+        bucket++;
+    }
+
+    _buckets[bucket].fetch_add( 1, std::memory_order_relaxed );
+    _sum_ns.fetch_add( static_cast<uint64_t>( ns ), std::memory_order_relaxed );
+}
+
+void metric_histogram_t::render( const std::string& name, const std::string& labels, std::string& out ) const {
+
+    const std::string prefix = labels.empty( ) ? std::string( ) : labels + ",";
+    const std::string suffix = labels.empty( ) ? std::string( ) : "{" + labels + "}";
+
+    uint64_t cumulative = 0;
+
+    for ( size_t i = 0; i <= BUCKETS; i++ ) {
+
+        cumulative += _buckets[i].load( std::memory_order_relaxed );
+
+        out.append( name ).append( "_bucket{" ).append( prefix ).append( "le=\"" )
+            .append( i < BUCKETS ? BUCKET_LABELS[i] : "+Inf" ).append( "\"} " )
+            .append( std::to_string( cumulative ) ).append( "\n" );
+    }
+
+    char sum[32];
+    std::snprintf( sum, sizeof( sum ), "%.6f", static_cast<double>( _sum_ns.load( std::memory_order_relaxed ) ) / 1e9 );
+
+    out.append( name ).append( "_sum" ).append( suffix ).append( " " ).append( sum ).append( "\n" );
+    out.append( name ).append( "_count" ).append( suffix ).append( " " ).append( std::to_string( cumulative ) ).append( "\n" );
+}
+
+metric_timer_t::metric_timer_t( metric_histogram_t& histogram ) : _histogram( histogram ), _start( std::chrono::steady_clock::now( ) ) { }
+
+metric_timer_t::~metric_timer_t( ) {
+    _histogram.observe( std::chrono::steady_clock::now( ) - _start );
+}
+
+service_metrics_t::family& service_metrics_t::get_family( const std::string& name, const char* help, bool is_histogram ) {
+
+    auto it = _families.find( name );
+
+    if ( it == _families.end( ) ) {
+        family& created = _families[name];
+        created.help = help;
+        created.is_histogram = is_histogram;
+        return created;
+    }
+
+    if ( it->second.is_histogram != is_histogram ) {
+        throw std::runtime_error( "Metric \"" + name + "\" registered with another type" );
+    }
+
+    return it->second;
+}
+
+metric_counter_t& service_metrics_t::counter( const std::string& name, const char* help, const std::string& labels ) {
+
+    std::lock_guard<std::mutex> lock( _mutex );
+
+    std::unique_ptr<metric_counter_t>& metric = get_family( name, help, false ).counters[labels];
+
+    if ( !metric ) {
+        metric = std::make_unique<metric_counter_t>( );
+    }
+
+    return *metric;
+}
+
+metric_histogram_t& service_metrics_t::histogram( const std::string& name, const char* help, const std::string& labels ) {
+
+    std::lock_guard<std::mutex> lock( _mutex );
+
+    std::unique_ptr<metric_histogram_t>& metric = get_family( name, help, true ).histograms[labels];
+
+    if ( !metric ) {
+        metric = std::make_unique<metric_histogram_t>( );
+    }
+
+    return *metric;
+}
+
+void service_metrics_t::render( std::string& out ) const {
+
+    std::lock_guard<std::mutex> lock( _mutex );
+
+    for ( const auto& [name, metrics] : _families ) {
+
+        out.append( "# HELP " ).append( name ).append( " " ).append( metrics.help ).append( "\n" );
+        out.append( "# TYPE " ).append( name ).append( metrics.is_histogram ? " histogram\n" : " counter\n" );
+
+        for ( const auto& [labels, counter] : metrics.counters ) {
+            out.append( name );
+            if ( !labels.empty( ) ) out.append( "{" ).append( labels ).append( "}" );
+            out.append( " " ).append( std::to_string( counter->get( ) ) ).append( "\n" );
+        }
+
+        for ( const auto& [labels, histogram] : metrics.histograms ) {
+            histogram->render( name, labels, out );
+        }
+    }
+}
+
+service_metrics_t& _metrics( ) {
+    static service_metrics_t metrics;
+    return metrics;
+}
+
+std::string _metric_label( const char* key, const std::string& value ) {
+
+    std::string label( key );
+    label.append( "=\"" );
+
+    for ( char c : value ) {
+        switch ( c ) {
+            case '\\': label.append( "\\\\" ); break;
+            case '"': label.append( "\\\"" ); break;
+            case '\n': label.append( "\\n" ); break;
+            default: label.push_back( c ); break;
+        }
+    }
+
+    label.push_back( '"' );
+
+    return label;
+}
+
+metrics_server_t::metrics_server_t( service_reactor_t& reactor ) : _reactor( reactor ) { }
+
+metrics_server_t::~metrics_server_t( ) {
+    close( );
+}
+
+void metrics_server_t::set_last_error( const char* action ) {
+    _last_error = std::string( action ) + ": " + std::strerror( errno );
+}
+
+const char* metrics_server_t::get_last_error( ) {
+    return _last_error.c_str( );
+}
+
+int metrics_server_t::open( int port ) {
+
+    sockaddr_in address{ };
+    address.sin_family = AF_INET;
+    address.sin_port = htons( static_cast<uint16_t>( port ) );
+    // Never exposed beyond this host
+    address.sin_addr.s_addr = htonl( INADDR_LOOPBACK );
+
+    _listen_fd = socket( AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0 );
+
+    if ( _listen_fd < 0 ) {
+        set_last_error( "socket" );
+        return -1;
+    }
+
+    int reuse = 1;
+    setsockopt( _listen_fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof( reuse ) );
+
+    int bound = bind( _listen_fd, reinterpret_cast<sockaddr*>( &address ), sizeof( address ) );
+
+    if ( bound < 0 || listen( _listen_fd, 8 ) < 0 ) {
+        set_last_error( bound < 0 ? "bind" : "listen" );
+        ::close( _listen_fd );
+        _listen_fd = -1;
+        return -1;
+    }
+
+    if ( _reactor.add( _listen_fd, EPOLLIN, [this]( uint32_t /*events*/ ) { accept_connections( ); } ) < 0 ) {
+        _last_error = _reactor.get_last_error( );
+        ::close( _listen_fd );
+        _listen_fd = -1;
+        return -1;
+    }
+
+    return 1;
+}
+
+void metrics_server_t::close( ) {
+
+    while ( !_connections.empty( ) ) {
+        drop( _connections.begin( )->first );
+    }
+
+    if ( _listen_fd >= 0 ) {
+        _reactor.remove( _listen_fd );
+        ::close( _listen_fd );
+        _listen_fd = -1;
+    }
+}
+
+void metrics_server_t::accept_connections( ) {
+
+    while ( true ) {
+
+        int fd = accept4( _listen_fd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC );
+
+        if ( fd < 0 ) return;
+
+        if ( _connections.size( ) >= MAX_CONNECTIONS ) {
+            ::close( fd );
+            continue;
+        }
+
+        if ( _reactor.add( fd, EPOLLIN, [this, fd]( uint32_t events ) {
+
+            if ( events & ( EPOLLHUP | EPOLLERR ) ) {
+                drop( fd );
+                return;
+            }
+
+            if ( events & EPOLLOUT ) {
+                flush( fd );
+                return;
+            }
+
+            if ( events & EPOLLIN ) {
+                on_readable( fd );
+            }
+
+        }) < 0 ) {
+            ::close( fd );
+            continue;
+        }
+
+        _connections[fd];
+    }
+}
+
+void metrics_server_t::on_readable( int fd ) {
+
+    auto it = _connections.find( fd );
+
+    if ( it == _connections.end( ) ) return;
+
+    // The response is already queued, the rest of the request is ignored
+    if ( !it->second.output.empty( ) ) return;
+
+    char buffer[1024];
+
+    while ( true ) {
+
+        ssize_t length = read( fd, buffer, sizeof( buffer ) );
+
+        if ( length == 0 || ( length < 0 && errno != EAGAIN && errno != EWOULDBLOCK ) ) {
+            drop( fd );
+            return;
+        }
+
+        if ( length < 0 ) break;
+
+        it->second.input.append( buffer, static_cast<size_t>( length ) );
+    }
+
+    const std::string& input = it->second.input;
+
+    if ( input.find( "\r\n\r\n" ) == std::string::npos && input.find( "\n\n" ) == std::string::npos ) {
+
+        if ( input.size( ) > MAX_REQUEST_LENGTH ) {
+            drop( fd );
+        }
+
+        return;
+    }
+
+    respond( it->second );
+
+    flush( fd );
+}
+
+void metrics_server_t::respond( connection& conn ) {
+
+    // e.g. "GET /metrics HTTP/1.1"
+    const std::string& input = conn.input;
+
+    size_t method_end = input.find( ' ' );
+    size_t path_end = method_end == std::string::npos ? std::string::npos : input.find_first_of( " ?\r\n", method_end + 1 );
+
+    std::string method = input.substr( 0, method_end );
+    std::string path = path_end == std::string::npos ? std::string( ) : input.substr( method_end + 1, path_end - method_end - 1 );
+
+    const char* status = "200 OK";
+    std::string body;
+
+    if ( method != "GET" ) {
+        status = "405 Method Not Allowed";
+        body = "Only GET is supported\n";
+    } else if ( path != "/metrics" ) {
+        status = "404 Not Found";
+        body = "Metrics are served at /metrics\n";
+    } else {
+        _metrics( ).render( body );
+    }
+
+    conn.output.append( "HTTP/1.0 " ).append( status ).append( "\r\n" )
+        .append( "Content-Type: text/plain; version=0.0.4; charset=utf-8\r\n" )
+        .append( "Content-Length: " ).append( std::to_string( body.size( ) ) ).append( "\r\n" )
+        .append( "Connection: close\r\n\r\n" )
+        .append( body );
+
+    conn.input.clear( );
+}
+
+void metrics_server_t::flush( int fd ) {
+
+    auto it = _connections.find( fd );
+
+    if ( it == _connections.end( ) ) return;
+
+    std::string& output = it->second.output;
+
+    while ( !output.empty( ) ) {
+
+        ssize_t written = send( fd, output.data( ), output.size( ), MSG_NOSIGNAL );
+
+        if ( written < 0 ) {
+
+            if ( errno == EAGAIN || errno == EWOULDBLOCK ) break;
+
+            drop( fd );
+            return;
+        }
+
+        output.erase( 0, static_cast<size_t>( written ) );
+    }
+
+    // One response per connection
+    if ( output.empty( ) ) {
+        drop( fd );
+        return;
+    }
+
+    _reactor.modify( fd, EPOLLOUT );
+}
+
+void metrics_server_t::drop( int fd ) {
+    _reactor.remove( fd );
+    ::close( fd );
+    _connections.erase( fd );
+}
@@ -0,0 +1,476 @@
+/*
+* Copyright FSys Tech Limited [FSys]. All rights reserved.
+*
+* This software owned by FSys Tech Limited [FSys] and is protected by copyright law
+* and international copyright treaties.
+*
+* Access to and use of the software is governed by the terms of the applicable FSys Software
+* Services Agreement (the Agreement) and Customer end user license agreements granting
+* a non-assignable, non-transferable and non-exclusive license to use the software
+* for it's own data processing purposes under the terms defined in the Agreement.
+*
+* Except as otherwise granted within the terms of the Agreement, copying or reproduction of any part
+* of this source code or associated reference material to any other location for further reproduction
+* or redistribution, and any amendments to this copyright notice, are expressly prohibited.
+*
+* Any reproduction or redistribution for sale or hiring of the Software not in accordance with
+* the terms of the Agreement is a violation of copyright law.
+*/
+// 11:05 AM 10/16/2026
+// by Rajib Chy
+#ifdef _MSC_VER
+#pragma once
+#endif//_MSC_VER
+
+#ifndef USE_PRODUCTION_BUILD
+
+#include <svc/mock-systemd.h>
+#include <cstdio>
+#include <csignal>
+#include <cerrno>
+#include <cstring>
+#include <poll.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include <sys/prctl.h>
+
+constexpr const char MOCK_SYSTEMD[] = "org.freedesktop.systemd1";
+constexpr const char MOCK_SYSTEMD_PATH[] = "/org/freedesktop/systemd1";
+constexpr const char MOCK_UNIT_PATH[] = "/org/freedesktop/systemd1/unit/";
+constexpr const char MOCK_JOB_PATH[] = "/org/freedesktop/systemd1/job/";
+constexpr const char MOCK_MANAGER_INTERFACE[] = "org.freedesktop.systemd1.Manager";
+constexpr const char MOCK_UNIT_INTERFACE[] = "org.freedesktop.systemd1.Unit";
+constexpr const char MOCK_SERVICE_INTERFACE[] = "org.freedesktop.systemd1.Service";
+
+// How long the daemon may take to print its address
+constexpr int BUS_START_TIMEOUT_MS = 5000;
+
+// Exit status of a main process killed by SIGKILL
+constexpr int32_t KILLED_STATUS = 9;
+
+// name, description, load state, active state, sub state, followed, unit path, job id, job type, job path
+using mock_unit_info = sdbus::Struct<
+    std::string, std::string, std::string, std::string, std::string,
+    std::string, sdbus::ObjectPath, uint32_t, std::string, sdbus::ObjectPath
+>;
+
+// Wall clock in microseconds, the unit of systemd's timestamps
+static uint64_t _realtime_usec( ) {
+    return static_cast<uint64_t>( std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::system_clock::now( ).time_since_epoch( )
+    ).count( ) );
+}
+
+private_bus_t::~private_bus_t( ) {
+    stop( );
+}
+
+int private_bus_t::start( const std::string& daemon ) {
+
+    if ( _pid > 0 ) return 1;
+
+    int fds[2];
+
+    if ( pipe( fds ) < 0 ) {
+        _last_error = std::string( "pipe failed: " ) + strerror( errno );
+        return -1;
+    }
+
+    pid_t pid = fork( );
+
+    if ( pid < 0 ) {
+        _last_error = std::string( "fork failed: " ) + strerror( errno );
+        close( fds[0] );
+        close( fds[1] );
+        return -1;
+    }
+
+    if ( pid == 0 ) {
+        // Never outlive the harness, even if it is killed
+        prctl( PR_SET_PDEATHSIG, SIGTERM );
+        close( fds[0] );
+
+        std::string print_address = "--print-address=" + std::to_string( fds[1] );
+
+        execlp(
+            daemon.c_str( ), daemon.c_str( ), "--session", "--nofork", "--nopidfile",
+            "--address=unix:tmpdir=/tmp", print_address.c_str( ), static_cast<char*>( nullptr )
+        );
+        _exit( 127 );
+    }
+
+    close( fds[1] );
+    _pid = pid;
+
+    // The address is printed as a single line once the daemon listens
+    std::string address;
+    char buffer[256];
+    auto deadline = std::chrono::steady_clock::now( ) + std::chrono::milliseconds( BUS_START_TIMEOUT_MS );
+
+    while ( address.find( '\n' ) == std::string::npos ) {
+
+        int remaining = static_cast<int>( std::chrono::duration_cast<std::chrono::milliseconds>(
+            deadline - std::chrono::steady_clock::now( )
+        ).count( ) );
+
+        struct pollfd pfd = { fds[0], POLLIN, 0 };
+
+        if ( remaining <= 0 || poll( &pfd, 1, remaining ) <= 0 ) {
+            _last_error = "dbus-daemon did not print its address in time";
+            break;
+        }
+
+        ssize_t n = read( fds[0], buffer, sizeof( buffer ) );
+
+        if ( n <= 0 ) {
+            _last_error = "dbus-daemon exited before printing its address";
+            break;
+        }
+
+        address.append( buffer, static_cast<size_t>( n ) );
+    }
+
+    close( fds[0] );
+
+    size_t end = address.find( '\n' );
+
+    if ( end == std::string::npos ) {
+        stop( );
+        return -1;
+    }
+
+    _address = address.substr( 0, end );
+
+    return 1;
+}
+
+void private_bus_t::stop( ) {
+
+    if ( _pid <= 0 ) return;
+
+    ::kill( _pid, SIGTERM );
+
+    int status;
+    while ( waitpid( _pid, &status, 0 ) < 0 && errno == EINTR ) { }
+
+    _pid = -1;
+    _address.clear( );
+}
+
+const std::string& private_bus_t::get_address( ) const {
+    return _address;
+}
+
+const char* private_bus_t::get_last_error( ) {
+    if ( _last_error.empty( ) ) {
+        return nullptr;
+    }
+    return _last_error.c_str( );
+}
+
+mock_systemd_t::mock_systemd_t( const std::string& bus_address, std::chrono::milliseconds job_delay ) : _job_delay( job_delay ) {
+
+    _connection = sdbus::createSessionBusConnectionWithAddress( bus_address );
+    _connection->requestName( sdbus::ServiceName( MOCK_SYSTEMD ) );
+
+    register_manager( );
+
+    _thread = std::thread( &mock_systemd_t::run, this );
+    _connection->enterEventLoopAsync( );
+}
+
+mock_systemd_t::~mock_systemd_t( ) {
+
+    {
+        std::lock_guard<std::mutex> lock( _mutex );
+        _stopping = true;
+    }
+
+    _cv.notify_all( );
+
+    if ( _thread.joinable( ) ) {
+        _thread.join( );
+    }
+
+    _connection->leaveEventLoop( );
+
+    // Objects go before the connection they are exported on
+    _units.clear( );
+    _manager.reset( );
+}
+
+uint64_t mock_systemd_t::calls( ) const {
+    return _calls.load( );
+}
+
+void mock_systemd_t::register_manager( ) {
+
+    _manager = sdbus::createObject( *_connection, sdbus::ObjectPath( MOCK_SYSTEMD_PATH ) );
+
+    _manager->addVTable(
+        sdbus::registerMethod( sdbus::MethodName( "LoadUnit" ) ).implementedAs( [this]( const std::string& name ) {
+            _calls++;
+            std::lock_guard<std::mutex> lock( _mutex );
+            return load_unit( name ).path;
+        }),
+        sdbus::registerMethod( sdbus::MethodName( "GetUnit" ) ).implementedAs( [this]( const std::string& name ) {
+            _calls++;
+            std::lock_guard<std::mutex> lock( _mutex );
+            auto it = _units.find( name );
+            if ( it == _units.end( ) ) {
+                throw sdbus::Error( sdbus::Error::Name( "org.freedesktop.systemd1.NoSuchUnit" ), "Unit " + name + " not loaded." );
+            }
+            return it->second.path;
+        }),
+        sdbus::registerMethod( sdbus::MethodName( "StartUnit" ) ).implementedAs( [this]( const std::string& name, const std::string& /*mode*/ ) {
+            return queue_job( unit_operation::START, name );
+        }),
+        sdbus::registerMethod( sdbus::MethodName( "StopUnit" ) ).implementedAs( [this]( const std::string& name, const std::string& /*mode*/ ) {
+            return queue_job( unit_operation::STOP, name );
+        }),
+        sdbus::registerMethod( sdbus::MethodName( "RestartUnit" ) ).implementedAs( [this]( const std::string& name, const std::string& /*mode*/ ) {
+            return queue_job( unit_operation::RESTART, name );
+        }),
+        sdbus::registerMethod( sdbus::MethodName( "ResetFailedUnit" ) ).implementedAs( [this]( const std::string& name ) {
+            _calls++;
+            {
+                std::lock_guard<std::mutex> lock( _mutex );
+                mock_unit& unit = load_unit( name );
+                if ( unit.status.active_state != unit_active_state::FAILED ) return;
+                unit.status.active_state = unit_active_state::INACTIVE;
+                unit.status.sub_state = unit_sub_state::DEAD;
+            }
+            emit_unit_changed( name );
+        }),
+        sdbus::registerMethod( sdbus::MethodName( "ListUnitsByNames" ) ).implementedAs( [this]( const std::vector<std::string>& names ) {
+            _calls++;
+            std::vector<mock_unit_info> units;
+            std::lock_guard<std::mutex> lock( _mutex );
+            for ( const auto& name : names ) {
+                const mock_unit& unit = load_unit( name );
+                units.push_back( mock_unit_info(
+                    name, name, "loaded", _unit_active_state_name( unit.status.active_state ),
+                    _unit_sub_state_name( unit.status.sub_state ), "", unit.path, 0u, "", sdbus::ObjectPath( "/" )
+                ) );
+            }
+            return units;
+        }),
+        sdbus::registerMethod( sdbus::MethodName( "Subscribe" ) ).implementedAs( [this]( ) {
+            _calls++;
+        }),
+        sdbus::registerSignal( sdbus::SignalName( "UnitNew" ) ).withParameters<std::string, sdbus::ObjectPath>( ),
+        sdbus::registerSignal( sdbus::SignalName( "UnitRemoved" ) ).withParameters<std::string, sdbus::ObjectPath>( ),
+        sdbus::registerSignal( sdbus::SignalName( "JobRemoved" ) ).withParameters<uint32_t, sdbus::ObjectPath, std::string, std::string>( ),
+        sdbus::registerSignal( sdbus::SignalName( "Reloading" ) ).withParameters<bool>( )
+    ).forInterface( sdbus::InterfaceName( MOCK_MANAGER_INTERFACE ) );
+}
+
+mock_systemd_t::mock_unit& mock_systemd_t::load_unit( const std::string& service_name ) {
+
+    // Caller holds _mutex
+    auto it = _units.find( service_name );
+
+    if ( it != _units.end( ) ) return it->second;
+
+    mock_unit& unit = _units[service_name];
+    unit.path = sdbus::ObjectPath( MOCK_UNIT_PATH + _escape_unit_path_label( service_name ) );
+    unit.status.sub_state = unit_sub_state::DEAD;
+    unit.object = sdbus::createObject( *_connection, unit.path );
+
+    // The getters run on the event loop thread, which holds no lock then
+    auto read = [this, service_name]( ) {
+        std::lock_guard<std::mutex> lock( _mutex );
+        return _units[service_name].status;
+    };
+
+    unit.object->addVTable(
+        sdbus::registerProperty( sdbus::PropertyName( "Id" ) ).withGetter( [service_name]( ) { return service_name; } ),
+        sdbus::registerProperty( sdbus::PropertyName( "ActiveState" ) ).withGetter( [read]( ) {
+            return std::string( _unit_active_state_name( read( ).active_state ) );
+        }),
+        sdbus::registerProperty( sdbus::PropertyName( "SubState" ) ).withGetter( [read]( ) {
+            return std::string( _unit_sub_state_name( read( ).sub_state ) );
+        }),
+        sdbus::registerProperty( sdbus::PropertyName( "ActiveEnterTimestamp" ) ).withGetter( [read]( ) {
+            return read( ).active_enter_timestamp;
+        }),
+        sdbus::registerProperty( sdbus::PropertyName( "InactiveExitTimestamp" ) ).withGetter( [read]( ) {
+            return read( ).inactive_exit_timestamp;
+        })
+    ).forInterface( sdbus::InterfaceName( MOCK_UNIT_INTERFACE ) );
+
+    unit.object->addVTable(
+        sdbus::registerProperty( sdbus::PropertyName( "MainPID" ) ).withGetter( [read]( ) {
+            return read( ).main_pid;
+        }),
+        sdbus::registerProperty( sdbus::PropertyName( "NRestarts" ) ).withGetter( [read]( ) {
+            return read( ).restarts;
+        }),
+        sdbus::registerProperty( sdbus::PropertyName( "ExecMainStatus" ) ).withGetter( [read]( ) {
+            return read( ).exec_main_status;
+        })
+    ).forInterface( sdbus::InterfaceName( MOCK_SERVICE_INTERFACE ) );
+
+    return unit;
+}
+
+sdbus::ObjectPath mock_systemd_t::queue_job( unit_operation operation, const std::string& service_name ) {
+
+    _calls++;
+
+    sdbus::ObjectPath job_path;
+    bool changed = false;
+
+    {
+        std::lock_guard<std::mutex> lock( _mutex );
+
+        mock_unit& unit = load_unit( service_name );
+
+        uint32_t id = _next_job++;
+        job_path = sdbus::ObjectPath( MOCK_JOB_PATH + std::to_string( id ) );
+
+        // The job runs from now on, like systemd's transition into the transient states
+        if ( operation == unit_operation::STOP ) {
+            if ( unit.status.active_state == unit_active_state::ACTIVE ) {
+                unit.status.active_state = unit_active_state::DEACTIVATING;
+                unit.status.sub_state = unit_sub_state::STOP_SIGTERM;
+                changed = true;
+            }
+        } else if ( unit.status.active_state != unit_active_state::ACTIVE || operation == unit_operation::RESTART ) {
+            unit.status.active_state = unit_active_state::ACTIVATING;
+            unit.status.sub_state = unit_sub_state::START;
+            unit.status.inactive_exit_timestamp = _realtime_usec( );
+            changed = true;
+        }
+
+        _jobs.emplace( std::chrono::steady_clock::now( ) + _job_delay, mock_job{ id, job_path, service_name, operation } );
+    }
+
+    _cv.notify_all( );
+
+    if ( changed ) {
+        emit_unit_changed( service_name );
+    }
+
+    return job_path;
+}
+
+void mock_systemd_t::kill( const std::string& service_name ) {
+
+    {
+        std::lock_guard<std::mutex> lock( _mutex );
+
+        auto it = _units.find( service_name );
+
+        if ( it == _units.end( ) || it->second.status.active_state != unit_active_state::ACTIVE ) return;
+
+        unit_status& status = it->second.status;
+        status.active_state = unit_active_state::FAILED;
+        status.sub_state = unit_sub_state::FAILED;
+        status.main_pid = 0;
+        status.exec_main_status = KILLED_STATUS;
+    }
+
+    emit_unit_changed( service_name );
+}
+
+void mock_systemd_t::emit_unit_changed( const std::string& service_name ) {
+
+    sdbus::IObject* object;
+
+    {
+        // Unit objects live as long as this instance
+        std::lock_guard<std::mutex> lock( _mutex );
+        object = _units[service_name].object.get( );
+    }
+
+    object->emitPropertiesChangedSignal( sdbus::InterfaceName( MOCK_UNIT_INTERFACE ), {
+        sdbus::PropertyName( "ActiveState" ), sdbus::PropertyName( "SubState" ),
+        sdbus::PropertyName( "ActiveEnterTimestamp" ), sdbus::PropertyName( "InactiveExitTimestamp" )
+    });
+
+    object->emitPropertiesChangedSignal( sdbus::InterfaceName( MOCK_SERVICE_INTERFACE ), {
+        sdbus::PropertyName( "MainPID" ), sdbus::PropertyName( "NRestarts" ), sdbus::PropertyName( "ExecMainStatus" )
+    });
+}
+
+void mock_systemd_t::run( ) {
+
+    std::vector<mock_job> finished;
+
+    while ( true ) {
+
+        finished.clear( );
+
+        {
+            std::unique_lock<std::mutex> lock( _mutex );
+
+            // Woken for an earlier job as well; nothing may be due yet then
+            if ( _jobs.empty( ) ) {
+                _cv.wait( lock, [this]( ) { return _stopping || !_jobs.empty( ); } );
+            } else {
+                _cv.wait_until( lock, _jobs.begin( )->first );
+            }
+
+            if ( _stopping ) return;
+
+            const auto now = std::chrono::steady_clock::now( );
+
+            while ( !_jobs.empty( ) && _jobs.begin( )->first <= now ) {
+
+                mock_job job = std::move( _jobs.begin( )->second );
+                _jobs.erase( _jobs.begin( ) );
+
+                unit_status& status = _units[job.service_name].status;
+
+                if ( job.operation == unit_operation::STOP ) {
+                    status.active_state = unit_active_state::INACTIVE;
+                    status.sub_state = unit_sub_state::DEAD;
+                    status.main_pid = 0;
+                    status.exec_main_status = 0;
+                } else if ( status.active_state != unit_active_state::ACTIVE ) {
+                    status.active_state = unit_active_state::ACTIVE;
+                    status.sub_state = unit_sub_state::RUNNING;
+                    status.main_pid = _next_pid++;
+                    status.exec_main_status = 0;
+                    status.active_enter_timestamp = _realtime_usec( );
+                }
+
+                finished.push_back( std::move( job ) );
+            }
+        }
+
+        // Like systemd: the properties change before the job is removed
+        for ( const auto& job : finished ) {
+
+            emit_unit_changed( job.service_name );
+
+            _manager->emitSignal( sdbus::SignalName( "JobRemoved" ) )
+                .onInterface( sdbus::InterfaceName( MOCK_MANAGER_INTERFACE ) )
+                .withArguments( job.id, job.path, job.service_name, std::string( "done" ) );
+        }
+    }
+}
+
+std::string _escape_unit_path_label( const std::string& service_name ) {
+
+    static const char HEX[] = "0123456789abcdef";
+
+    std::string label;
+    label.reserve( service_name.size( ) * 3 );
+
+    for ( unsigned char c : service_name ) {
+        if ( ( c >= 'a' && c <= 'z' ) || ( c >= 'A' && c <= 'Z' ) || ( c >= '0' && c <= '9' ) ) {
+            label.push_back( static_cast<char>( c ) );
+        } else {
+            label.push_back( '_' );
+            label.push_back( HEX[c >> 4] );
+            label.push_back( HEX[c & 0x0f] );
+        }
+    }
+
+    return label;
+}
+
+#endif // !USE_PRODUCTION_BUILD
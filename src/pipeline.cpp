@@ -0,0 +1,147 @@
+/*
+* Copyright FSys Tech Limited [FSys]. All rights reserved.
+*
+* This software owned by FSys Tech Limited [FSys] and is protected by copyright law
+* and international copyright treaties.
+*
+* Access to and use of the software is governed by the terms of the applicable FSys Software
+* Services Agreement (the Agreement) and Customer end user license agreements granting
+* a non-assignable, non-transferable and non-exclusive license to use the software
+* for it's own data processing purposes under the terms defined in the Agreement.
+*
+* Except as otherwise granted within the terms of the Agreement, copying or reproduction of any part
+* of this source code or associated reference material to any other location for further reproduction
+* or redistribution, and any amendments to this copyright notice, are expressly prohibited.
+*
+* Any reproduction or redistribution for sale or hiring of the Software not in accordance with
+* the terms of the Agreement is a violation of copyright law.
+*/
+// 3:15 PM 10/18/2026
+// by Rajib Chy
+
+#include <svc/pipeline.h>
+#include <chrono>
+
+background_pipeline_t::background_pipeline_t( std::function<void( )> notify ) : _notify( std::move( notify ) ) { }
+
+background_pipeline_t::~background_pipeline_t( ) {
+    stop( );
+}
+
+int background_pipeline_t::start( std::vector<std::pair<std::string, stage>> stages, completion done ) {
+
+    std::lock_guard<std::mutex> lock( _mutex );
+
+    if ( _running || _stopping ) return 0;
+
+    _stages = std::move( stages );
+    _done = std::move( done );
+    _running = true;
+    _finished = false;
+    _pending = true;
+
+    // Started on first use, most days it runs once
+    if ( !_thread.joinable( ) ) {
+        _thread = std::thread( &background_pipeline_t::run, this );
+    }
+
+    _cv.notify_all( );
+
+    return 1;
+}
+
+bool background_pipeline_t::is_running( ) const {
+    std::lock_guard<std::mutex> lock( _mutex );
+    return _running;
+}
+
+int background_pipeline_t::drain( ) {
+
+    completion done;
+    int status;
+    std::string failed_stage;
+
+    {
+        std::lock_guard<std::mutex> lock( _mutex );
+
+        if ( !_running || !_finished ) return 0;
+
+        done = std::move( _done );
+        status = _status;
+        failed_stage.swap( _failed_stage );
+        _running = false;
+        _finished = false;
+    }
+
+    if ( done ) {
+        done( status, failed_stage );
+    }
+
+    return 1;
+}
+
+int background_pipeline_t::sleep_for( long ms ) {
+
+    std::unique_lock<std::mutex> lock( _mutex );
+
+    return _cv.wait_for( lock, std::chrono::milliseconds( ms ), [this]( ) { return _stopping.load( ); } ) ? 0 : 1;
+}
+
+void background_pipeline_t::stop( ) {
+
+    {
+        std::lock_guard<std::mutex> lock( _mutex );
+        _stopping = true;
+    }
+
+    _cv.notify_all( );
+
+    if ( _thread.joinable( ) ) {
+        _thread.join( );
+    }
+}
+
+void background_pipeline_t::run( ) {
+
+    while ( true ) {
+
+        std::vector<std::pair<std::string, stage>> stages;
+
+        {
+            std::unique_lock<std::mutex> lock( _mutex );
+
+            _cv.wait( lock, [this]( ) { return _pending || _stopping; } );
+
+            if ( _stopping ) return;
+
+            stages.swap( _stages );
+            _pending = false;
+        }
+
+        int status = 1;
+        std::string failed_stage;
+
+        for ( auto& [name, body] : stages ) {
+
+            if ( _stopping ) return;
+
+            if ( body( ) == 0 ) {
+                status = 0;
+                failed_stage = name;
+                break;
+            }
+        }
+
+        // Interrupted by stop, nobody drains it any more
+        if ( _stopping ) return;
+
+        {
+            std::lock_guard<std::mutex> lock( _mutex );
+            _status = status;
+            _failed_stage = std::move( failed_stage );
+            _finished = true;
+        }
+
+        _notify( );
+    }
+}
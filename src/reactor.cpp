@@ -0,0 +1,277 @@
+/*
+* Copyright FSys Tech Limited [FSys]. All rights reserved.
+*
+* This software owned by FSys Tech Limited [FSys] and is protected by copyright law
+* and international copyright treaties.
+*
+* Access to and use of the software is governed by the terms of the applicable FSys Software
+* Services Agreement (the Agreement) and Customer end user license agreements granting
+* a non-assignable, non-transferable and non-exclusive license to use the software
+* for it's own data processing purposes under the terms defined in the Agreement.
+*
+* Except as otherwise granted within the terms of the Agreement, copying or reproduction of any part
+* of this source code or associated reference material to any other location for further reproduction
+* or redistribution, and any amendments to this copyright notice, are expressly prohibited.
+*
+* Any reproduction or redistribution for sale or hiring of the Software not in accordance with
+* the terms of the Agreement is a violation of copyright law.
+*/
+// 6:10 PM 10/16/2026
+// by Rajib Chy
+
+#include <svc/reactor.h>
+#include <stdexcept>
+#include <cerrno>
+#include <cstring>
+#include <csignal>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+#include <sys/eventfd.h>
+#include <sys/signalfd.h>
+#include <sys/inotify.h>
+
+// Events fetched per epoll_wait
+constexpr int MAX_EVENTS = 16;
+
+service_reactor_t::service_reactor_t( ) {
+
+    _epoll_fd = epoll_create1( EPOLL_CLOEXEC );
+    _timer_fd = timerfd_create( CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC );
+    _wake_fd = eventfd( 0, EFD_NONBLOCK | EFD_CLOEXEC );
+
+    if ( _epoll_fd < 0 || _timer_fd < 0 || _wake_fd < 0 ) {
+        std::string error = std::string( "Unable to create event loop: " ) + std::strerror( errno );
+
+        if ( _wake_fd >= 0 ) close( _wake_fd );
+        if ( _timer_fd >= 0 ) close( _timer_fd );
+        if ( _epoll_fd >= 0 ) close( _epoll_fd );
+
+        throw std::runtime_error( error );
+    }
+
+    epoll_event event{ };
+    event.events = EPOLLIN;
+
+    event.data.fd = _timer_fd;
+    epoll_ctl( _epoll_fd, EPOLL_CTL_ADD, _timer_fd, &event );
+
+    event.data.fd = _wake_fd;
+    epoll_ctl( _epoll_fd, EPOLL_CTL_ADD, _wake_fd, &event );
+}
+
+service_reactor_t::~service_reactor_t( ) {
+
+    for ( int fd : _owned_fds ) {
+        close( fd );
+    }
+
+    _owned_fds.clear( );
+
+    if ( _wake_fd >= 0 ) close( _wake_fd );
+    if ( _timer_fd >= 0 ) close( _timer_fd );
+    if ( _epoll_fd >= 0 ) close( _epoll_fd );
+
+    _wake_fd = _timer_fd = _epoll_fd = -1;
+}
+
+void service_reactor_t::set_last_error( const char* action ) {
+    _last_error = std::string( action ) + ": " + std::strerror( errno );
+}
+
+const char* service_reactor_t::get_last_error( ) {
+    return _last_error.c_str( );
+}
+
+int service_reactor_t::add( int fd, uint32_t events, fd_callback callback ) {
+
+    epoll_event event{ };
+    event.events = events;
+    event.data.fd = fd;
+
+    if ( epoll_ctl( _epoll_fd, EPOLL_CTL_ADD, fd, &event ) < 0 ) {
+        set_last_error( "epoll_ctl(ADD)" );
+        return -1;
+    }
+
+    _callbacks[fd] = std::move( callback );
+    return 1;
+}
+
+int service_reactor_t::modify( int fd, uint32_t events ) {
+
+    epoll_event event{ };
+    event.events = events;
+    event.data.fd = fd;
+
+    if ( epoll_ctl( _epoll_fd, EPOLL_CTL_MOD, fd, &event ) < 0 ) {
+        set_last_error( "epoll_ctl(MOD)" );
+        return -1;
+    }
+
+    return 1;
+}
+
+int service_reactor_t::remove( int fd ) {
+
+    _callbacks.erase( fd );
+
+    if ( epoll_ctl( _epoll_fd, EPOLL_CTL_DEL, fd, nullptr ) < 0 ) {
+        set_last_error( "epoll_ctl(DEL)" );
+        return -1;
+    }
+
+    return 1;
+}
+
+int service_reactor_t::add_signals( const std::vector<int>& signals, std::function<void( int signal )> callback ) {
+
+    sigset_t mask;
+    sigemptyset( &mask );
+
+    for ( int signal : signals ) {
+        sigaddset( &mask, signal );
+    }
+
+    int fd = signalfd( -1, &mask, SFD_NONBLOCK | SFD_CLOEXEC );
+
+    if ( fd < 0 ) {
+        set_last_error( "signalfd" );
+        return -1;
+    }
+
+    int result = add( fd, EPOLLIN, [fd, callback = std::move( callback )]( uint32_t /*events*/ ) {
+        signalfd_siginfo info;
+        while ( read( fd, &info, sizeof( info ) ) == static_cast<ssize_t>( sizeof( info ) ) ) {
+            callback( static_cast<int>( info.ssi_signo ) );
+        }
+    });
+
+    if ( result < 0 ) {
+        close( fd );
+        return -1;
+    }
+
+    _owned_fds.push_back( fd );
+    return 1;
+}
+
+int service_reactor_t::add_directory_watch( const std::string& path, std::function<void( const std::string& name )> callback ) {
+
+    int fd = inotify_init1( IN_NONBLOCK | IN_CLOEXEC );
+
+    if ( fd < 0 ) {
+        set_last_error( "inotify_init1" );
+        return -1;
+    }
+
+    // Editors either rewrite the file in place or move a new one over it
+    if ( inotify_add_watch( fd, path.c_str( ), IN_CLOSE_WRITE | IN_MOVED_TO ) < 0 ) {
+        set_last_error( "inotify_add_watch" );
+        close( fd );
+        return -1;
+    }
+
+    int result = add( fd, EPOLLIN, [fd, callback = std::move( callback )]( uint32_t /*events*/ ) {
+
+        alignas( inotify_event ) char buffer[4096];
+        ssize_t length;
+
+        while ( ( length = read( fd, buffer, sizeof( buffer ) ) ) > 0 ) {
+
+            for ( ssize_t offset = 0; offset < length; ) {
+
+                const inotify_event* event = reinterpret_cast<const inotify_event*>( buffer + offset );
+
+                if ( event->len > 0 ) {
+                    callback( std::string( event->name ) );
+                }
+
+                offset += sizeof( inotify_event ) + event->len;
+            }
+        }
+    });
+
+    if ( result < 0 ) {
+        close( fd );
+        return -1;
+    }
+
+    _owned_fds.push_back( fd );
+    return 1;
+}
+
+int service_reactor_t::poll( clock::time_point deadline ) {
+
+    if ( _stopped ) return 0;
+
+    itimerspec spec{ };
+
+    // A zero it_value would disarm the timer, a deadline already passed fires right away
+    if ( deadline != clock::time_point::max( ) ) {
+        auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>( deadline.time_since_epoch( ) ).count( );
+        if ( ns <= 0 ) ns = 1;
+        spec.it_value.tv_sec = static_cast<time_t>( ns / 1000000000 );
+        spec.it_value.tv_nsec = static_cast<long>( ns % 1000000000 );
+    }
+
+    // steady_clock counts CLOCK_MONOTONIC, so the deadline maps onto the timer as is
+    timerfd_settime( _timer_fd, TFD_TIMER_ABSTIME, &spec, nullptr );
+
+    epoll_event events[MAX_EVENTS];
+
+    int count = epoll_wait( _epoll_fd, events, MAX_EVENTS, -1 );
+
+    if ( count < 0 ) {
+        // Interrupted by an unblocked signal, the caller re-evaluates
+        return _stopped ? 0 : 1;
+    }
+
+    uint64_t value;
+
+    for ( int i = 0; i < count; i++ ) {
+
+        int fd = events[i].data.fd;
+
+        if ( fd == _timer_fd || fd == _wake_fd ) {
+            while ( read( fd, &value, sizeof( value ) ) > 0 ) { }
+            continue;
+        }
+
+        auto it = _callbacks.find( fd );
+
+        if ( it == _callbacks.end( ) ) continue;
+
+        // A copy, the callback may unregister its own descriptor
+        fd_callback callback = it->second;
+        callback( events[i].events );
+    }
+
+    return _stopped ? 0 : 1;
+}
+
+void service_reactor_t::wake( ) {
+    uint64_t value = 1;
+    write( _wake_fd, &value, sizeof( value ) );
+}
+
+void service_reactor_t::stop( ) {
+    _stopped = true;
+    wake( );
+}
+
+bool service_reactor_t::is_stopped( ) const {
+    return _stopped;
+}
+
+uint32_t _to_epoll_events( short events ) {
+
+    uint32_t result = 0;
+
+    if ( events & POLLIN ) result |= EPOLLIN;
+    if ( events & POLLOUT ) result |= EPOLLOUT;
+    if ( events & POLLPRI ) result |= EPOLLPRI;
+
+    return result;
+}
@@ -0,0 +1,152 @@
+/*
+* Copyright FSys Tech Limited [FSys]. All rights reserved.
+*
+* This software owned by FSys Tech Limited [FSys] and is protected by copyright law
+* and international copyright treaties.
+*
+* Access to and use of the software is governed by the terms of the applicable FSys Software
+* Services Agreement (the Agreement) and Customer end user license agreements granting
+* a non-assignable, non-transferable and non-exclusive license to use the software
+* for it's own data processing purposes under the terms defined in the Agreement.
+*
+* Except as otherwise granted within the terms of the Agreement, copying or reproduction of any part
+* of this source code or associated reference material to any other location for further reproduction
+* or redistribution, and any amendments to this copyright notice, are expressly prohibited.
+*
+* Any reproduction or redistribution for sale or hiring of the Software not in accordance with
+* the terms of the Agreement is a violation of copyright law.
+*/
+// 4:15 PM 10/16/2026
+// by Rajib Chy
+
+#include <svc/registry.h>
+#include <stdexcept>
+#include <algorithm>
+
+void service_registry_t::clear( ) {
+    _index.clear( );
+    _dependents.clear( );
+    _dependencies.clear( );
+    _order.clear( );
+}
+
+void service_registry_t::build( const service_table_t& services, std::vector<std::string>& unknown ) {
+
+    clear( );
+
+    _index.reserve( services.size( ) );
+    _dependents.resize( services.size( ) );
+    _dependencies.resize( services.size( ) );
+
+    for ( size_t i = 0; i < services.size( ); i++ ) {
+        if ( !_index.emplace( services.get_config( i ).service_name, i ).second ) {
+            throw std::runtime_error( "config->svc->[index]->name \"" + services.get_config( i ).service_name + "\" is not unique at ./svcm/config.json" );
+        }
+    }
+
+    for ( size_t i = 0; i < services.size( ); i++ ) {
+
+        for ( const auto& service_name : services.get_config( i ).dependent ) {
+
+            size_t dependent = find( service_name );
+
+            if ( dependent == npos ) {
+                unknown.push_back( services.get_config( i ).service_name + " -> " + service_name );
+                continue;
+            }
+
+            // Listing a dependent twice must not count as two edges
+            if ( std::find( _dependents[i].begin( ), _dependents[i].end( ), dependent ) != _dependents[i].end( ) ) {
+                continue;
+            }
+
+            _dependents[i].push_back( dependent );
+            _dependencies[dependent].push_back( i );
+        }
+    }
+
+    // Kahn's algorithm; services left over sit on a cycle
+    std::vector<size_t> in_degree( services.size( ) );
+    std::vector<size_t> ready;
+
+    for ( size_t i = 0; i < services.size( ); i++ ) {
+        in_degree[i] = _dependencies[i].size( );
+        if ( in_degree[i] == 0 ) {
+            ready.push_back( i );
+        }
+    }
+
+    _order.reserve( services.size( ) );
+
+    while ( !ready.empty( ) ) {
+
+        size_t index = ready.back( );
+        ready.pop_back( );
+        _order.push_back( index );
+
+        for ( size_t dependent : _dependents[index] ) {
+            if ( --in_degree[dependent] == 0 ) {
+                ready.push_back( dependent );
+            }
+        }
+    }
+
+    if ( _order.size( ) != services.size( ) ) {
+
+        std::string cycle;
+
+        for ( size_t i = 0; i < services.size( ); i++ ) {
+            if ( in_degree[i] > 0 ) {
+                cycle.append( cycle.empty( ) ? "" : ", " ).append( services.get_config( i ).service_name );
+            }
+        }
+
+        throw std::runtime_error( "config->svc->[index]->dependent forms a cycle (" + cycle + ") at ./svcm/config.json" );
+    }
+}
+
+size_t service_registry_t::size( ) const {
+    return _dependents.size( );
+}
+
+size_t service_registry_t::find( const std::string& service_name ) const {
+    auto it = _index.find( service_name );
+    return it == _index.end( ) ? npos : it->second;
+}
+
+const std::vector<size_t>& service_registry_t::get_dependents( size_t index ) const {
+    return _dependents[index];
+}
+
+const std::vector<size_t>& service_registry_t::get_dependencies( size_t index ) const {
+    return _dependencies[index];
+}
+
+void service_registry_t::get_levels( size_t root, std::vector<std::vector<size_t>>& levels ) const {
+
+    levels.clear( );
+
+    // Depth 0 marks services not below the root
+    std::vector<size_t> depth( _dependents.size( ), 0 );
+
+    for ( size_t dependent : _dependents[root] ) {
+        depth[dependent] = 1;
+    }
+
+    // Walking the topological order settles every dependency of a service before
+    // the service itself, so its longest distance from the root is final when reached
+    for ( size_t index : _order ) {
+
+        if ( depth[index] == 0 ) continue;
+
+        if ( levels.size( ) < depth[index] ) {
+            levels.resize( depth[index] );
+        }
+
+        levels[depth[index] - 1].push_back( index );
+
+        for ( size_t dependent : _dependents[index] ) {
+            depth[dependent] = std::max( depth[dependent], depth[index] + 1 );
+        }
+    }
+}
@@ -0,0 +1,54 @@
+/*
+* Copyright FSys Tech Limited [FSys]. All rights reserved.
+*
+* This software owned by FSys Tech Limited [FSys] and is protected by copyright law
+* and international copyright treaties.
+*
+* Access to and use of the software is governed by the terms of the applicable FSys Software
+* Services Agreement (the Agreement) and Customer end user license agreements granting
+* a non-assignable, non-transferable and non-exclusive license to use the software
+* for it's own data processing purposes under the terms defined in the Agreement.
+*
+* Except as otherwise granted within the terms of the Agreement, copying or reproduction of any part
+* of this source code or associated reference material to any other location for further reproduction
+* or redistribution, and any amendments to this copyright notice, are expressly prohibited.
+*
+* Any reproduction or redistribution for sale or hiring of the Software not in accordance with
+* the terms of the Agreement is a violation of copyright law.
+*/
+// 11:05 AM 10/16/2026
+// by Rajib Chy
+
+#include <svc/scheduler.h>
+
+void service_scheduler_t::clear( ) {
+    _queue = decltype( _queue )( );
+}
+
+void service_scheduler_t::schedule( std::time_t epoch, size_t service_index, schedule_event event ) {
+    _queue.push( schedule_entry{ epoch, service_index, event } );
+}
+
+bool service_scheduler_t::empty( ) const {
+    return _queue.empty( );
+}
+
+size_t service_scheduler_t::size( ) const {
+    return _queue.size( );
+}
+
+std::time_t service_scheduler_t::next_epoch( ) const {
+    return _queue.empty( ) ? 0 : _queue.top( ).epoch;
+}
+
+int service_scheduler_t::pop_due( const std::time_t& now_time, schedule_entry& entry ) {
+
+    if ( _queue.empty( ) || _queue.top( ).epoch > now_time ) {
+        return 0;
+    }
+
+    entry = _queue.top( );
+    _queue.pop( );
+
+    return 1;
+}
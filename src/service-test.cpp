@@ -26,9 +26,335 @@
 
 #include <cstring>
 #include <iostream>
+#include <chrono>
+#include <algorithm>
 #include <svc/httpc.h>
 #include <svc/logger.h>
 #include <svc/manager.h>
+#include <svc/reactor.h>
+#include <svc/worker-pool.h>
+#include <svc/fake-backend.h>
+#include <svc/mock-systemd.h>
+#include <cstdlib>
+#include <unistd.h>
+
+/**
+ * @brief Measures the wake-up jitter of `service_reactor_t::poll`.
+ *
+ * Waits `count` times for several durations through the reactor the monitor loop
+ * uses and logs the minimum, average and maximum delay between the requested
+ * deadline and the actual wake-up.
+ *
+ * @param logger Logger to report to.
+ * @param count Number of waits per duration.
+ */
+static void _bench_jitter( svc_logger& logger, int count ) {
+
+    service_reactor_t reactor;
+
+    for ( long ms : { 1L, 10L, 100L, 1000L } ) {
+
+        long long min_us = -1, max_us = 0, total_us = 0;
+
+        for ( int i = 0; i < count; i++ ) {
+
+            auto deadline = service_reactor_t::clock::now( ) + std::chrono::milliseconds( ms );
+
+            // Nothing is registered, so only the deadline (or a signal) ends a poll
+            while ( service_reactor_t::clock::now( ) < deadline ) {
+                reactor.poll( deadline );
+            }
+
+            long long late_us = std::chrono::duration_cast<std::chrono::microseconds>( service_reactor_t::clock::now( ) - deadline ).count( );
+
+            total_us += late_us;
+            max_us = std::max( max_us, late_us );
+            min_us = min_us < 0 ? late_us : std::min( min_us, late_us );
+        }
+
+        logger.info( "Wait ", ms, " ms: jitter min ", min_us, " us; avg ", total_us / count, " us; max ", max_us, " us\n" );
+    }
+}
+
+/**
+ * @brief Measures the per-call latency of a status check.
+ *
+ * Runs `count` status checks with a fresh systemd manager and unit proxy per call
+ * (the former behaviour), then the same number through `service_manager_t`, which
+ * reuses its manager proxy and cached unit proxies, and logs the average of both.
+ *
+ * @param logger Logger to report to.
+ * @param svc_manager Service manager under test.
+ * @param bus_address The bus `svc_manager` is connected to, empty for the system bus.
+ * @param svc_name The service to query (e.g. "example.service").
+ * @param count Number of calls per run.
+ */
+static void _bench_status( svc_logger& logger, service_manager_t& svc_manager, const std::string& bus_address, const std::string& svc_name, int count ) {
+
+    using clock = std::chrono::steady_clock;
+
+    std::unique_ptr<sdbus::IConnection> connection = bus_address.empty( )
+        ? sdbus::createSystemBusConnection( )
+        : sdbus::createSessionBusConnectionWithAddress( bus_address );
+    sdbus::ServiceName orgfsym = sdbus::ServiceName( "org.freedesktop.systemd1" );
+
+    auto started = clock::now( );
+
+    try {
+
+        for ( int i = 0; i < count; i++ ) {
+
+            std::unique_ptr<sdbus::IProxy> proxy = sdbus::createProxy(
+                *connection, orgfsym, sdbus::ObjectPath( "/org/freedesktop/systemd1" )
+            );
+
+            sdbus::ObjectPath object_path;
+            proxy->callMethod( "LoadUnit" )
+                .onInterface( "org.freedesktop.systemd1.Manager" )
+                .withArguments( svc_name )
+                .storeResultsTo( object_path );
+
+            auto unit_proxy = sdbus::createProxy( *connection, orgfsym, object_path );
+            unit_proxy->getProperty( "ActiveState" ).onInterface( "org.freedesktop.systemd1.Unit" );
+        }
+
+    } catch ( const sdbus::Error& e ) {
+
+        logger.error( "D-Bus error: ", e.what( ), "\n" );
+        return;
+
+    }
+
+    auto per_call_ns = std::chrono::duration_cast<std::chrono::nanoseconds>( clock::now( ) - started ).count( ) / count;
+
+    logger.info( "Proxy per call: ", per_call_ns / 1000, " us/call\n" );
+
+    std::string status;
+    started = clock::now( );
+
+    for ( int i = 0; i < count; i++ ) {
+        if ( svc_manager.get_status( svc_name, status ) < 0 ) {
+            logger.error( "Due to Error: ", svc_manager.get_last_error( ), "\n" );
+            return;
+        }
+    }
+
+    per_call_ns = std::chrono::duration_cast<std::chrono::nanoseconds>( clock::now( ) - started ).count( ) / count;
+
+    logger.info( "Persistent proxy: ", per_call_ns / 1000, " us/call\n" );
+
+    unit_status typed;
+    started = clock::now( );
+
+    for ( int i = 0; i < count; i++ ) {
+        if ( svc_manager.get_status( svc_name, typed ) < 0 ) {
+            logger.error( "Due to Error: ", svc_manager.get_last_error( ), "\n" );
+            return;
+        }
+    }
+
+    per_call_ns = std::chrono::duration_cast<std::chrono::nanoseconds>( clock::now( ) - started ).count( ) / count;
+
+    logger.info( "Typed GetAll: ", per_call_ns / 1000, " us/call\n" );
+}
+
+/**
+ * @brief Measures sequential against pipelined `StartUnit` calls.
+ *
+ * Starts the service `count` times with one blocking round-trip per call, then
+ * `count` times as a single `call_many` batch, and logs the total and per call
+ * time of both. Starting an active service queues a no-op job, so point it at a
+ * running unit.
+ *
+ * @param logger Logger to report to.
+ * @param svc_manager Service manager under test.
+ * @param svc_name The service to start (e.g. "example.service").
+ * @param count Number of calls per run.
+ */
+static void _bench_pipeline( svc_logger& logger, service_manager_t& svc_manager, const std::string& svc_name, int count ) {
+
+    using clock = std::chrono::steady_clock;
+
+    auto started = clock::now( );
+
+    for ( int i = 0; i < count; i++ ) {
+        if ( svc_manager.start( svc_name ) < 0 ) {
+            logger.error( "Due to Error: ", svc_manager.get_last_error( ), "\n" );
+            return;
+        }
+    }
+
+    auto sequential_us = std::chrono::duration_cast<std::chrono::microseconds>( clock::now( ) - started ).count( );
+
+    std::vector<unit_request> requests( static_cast<size_t>( count ) );
+
+    for ( auto& request : requests ) {
+        request.service_name = svc_name;
+    }
+
+    started = clock::now( );
+
+    if ( svc_manager.call_many( requests ) < 0 ) {
+        logger.error( "Due to Error: ", svc_manager.get_last_error( ), "\n" );
+        return;
+    }
+
+    auto pipelined_us = std::chrono::duration_cast<std::chrono::microseconds>( clock::now( ) - started ).count( );
+
+    logger.info( "Sequential: ", sequential_us, " us total, ", sequential_us / count, " us/call\n" );
+    logger.info( "Pipelined: ", pipelined_us, " us total, ", pipelined_us / count, " us/call\n" );
+}
+
+/**
+ * @brief Runs `count` actions through a worker pool and waits for all results.
+ *
+ * @return The elapsed microseconds, and the number of failed actions in `failed`.
+ */
+static long long _run_actions( service_worker_pool_t& pool, service_reactor_t& reactor, int count, service_action action, size_t& failed ) {
+
+    std::vector<action_result> results;
+    size_t finished = 0;
+    failed = 0;
+
+    auto started = std::chrono::steady_clock::now( );
+
+    // Queued together, so the workers send them as pipelined batches
+    pool.hold( );
+    for ( int i = 0; i < count; i++ ) {
+        pool.submit( static_cast<size_t>( i ), "fake-" + std::to_string( i ) + ".service", action );
+    }
+    pool.release( );
+
+    while ( finished < static_cast<size_t>( count ) ) {
+
+        reactor.poll( service_reactor_t::clock::now( ) + std::chrono::milliseconds( 100 ) );
+
+        pool.drain( results );
+        finished += results.size( );
+
+        for ( const auto& result : results ) {
+            if ( result.status != 1 || result.result != job_result::DONE ) failed++;
+        }
+    }
+
+    return std::chrono::duration_cast<std::chrono::microseconds>( std::chrono::steady_clock::now( ) - started ).count( );
+}
+
+/**
+ * @brief Benchmarks the worker pool and status queries against an in-memory fake systemd.
+ *
+ * Starts and stops `count` synthetic units, then reads their status one by one and
+ * in bulk, and logs the time of each step. Needs neither root nor systemd; equal
+ * arguments give equal call counts and failures.
+ *
+ * @param logger Logger to report to.
+ * @param count Number of synthetic units.
+ * @param workers Number of worker threads.
+ * @param latency_us Round-trip time of each fake call.
+ * @param job_ms Duration of each fake job.
+ * @param failure_rate Share of failing calls and start jobs.
+ */
+static void _bench_fake( svc_logger& logger, int count, int workers, long latency_us, long job_ms, double failure_rate ) {
+
+    fake_backend_config config;
+    config.start.latency = config.stop.latency = config.restart.latency = config.status.latency = std::chrono::microseconds( latency_us );
+    config.start.failure_rate = config.stop.failure_rate = failure_rate;
+    config.job_failure_rate = failure_rate;
+    config.job_duration = std::chrono::milliseconds( job_ms );
+
+    std::shared_ptr<fake_systemd_t> systemd = std::make_shared<fake_systemd_t>( config );
+    service_reactor_t reactor;
+    size_t failed = 0;
+
+    {
+        service_worker_pool_t pool( static_cast<size_t>( workers ), 60000, systemd->factory( ), [&reactor]( ) {
+            reactor.wake( );
+        });
+
+        long long start_us = _run_actions( pool, reactor, count, service_action::START, failed );
+        logger.info( "Start ", count, " units: ", start_us, " us; Failed: ", failed, "\n" );
+
+        long long stop_us = _run_actions( pool, reactor, count, service_action::STOP, failed );
+        logger.info( "Stop ", count, " units: ", stop_us, " us; Failed: ", failed, "\n" );
+    }
+
+    std::unique_ptr<service_backend_t> backend = systemd->factory( )( false );
+    std::vector<std::string> names;
+    unit_status status;
+
+    for ( int i = 0; i < count; i++ ) {
+        names.push_back( "fake-" + std::to_string( i ) + ".service" );
+    }
+
+    auto started = std::chrono::steady_clock::now( );
+
+    for ( const auto& name : names ) {
+        backend->get_status( name, status );
+    }
+
+    long long single_us = std::chrono::duration_cast<std::chrono::microseconds>( std::chrono::steady_clock::now( ) - started ).count( );
+
+    std::vector<unit_status> results;
+    started = std::chrono::steady_clock::now( );
+    backend->get_status_many( names, results );
+
+    long long bulk_us = std::chrono::duration_cast<std::chrono::microseconds>( std::chrono::steady_clock::now( ) - started ).count( );
+
+    logger.info( "Status of ", count, " units: ", single_us, " us one by one, ", bulk_us, " us in bulk\n" );
+    logger.info( "Fake calls: ", systemd->calls( ), "\n" );
+}
+
+/**
+ * @brief Runs the D-Bus microbenchmarks against a mock systemd on a private bus.
+ *
+ * Launches `dbus-daemon --session` (or `SVCM_DBUS_DAEMON`), serves a `mock_systemd_t`
+ * on it and runs the status and pipeline benchmarks through a `service_manager_t`
+ * connected to that bus, so the real sdbus-c++ code paths are measured without
+ * touching the host's systemd.
+ *
+ * @param logger Logger to report to.
+ * @param count Number of calls per run.
+ * @param serve Keep serving after the benchmarks until interrupted, for other clients.
+ */
+static void _bench_mock( svc_logger& logger, int count, bool serve ) {
+
+    const char* daemon = std::getenv( "SVCM_DBUS_DAEMON" );
+
+    private_bus_t bus;
+
+    if ( bus.start( daemon != nullptr ? daemon : "dbus-daemon" ) < 0 ) {
+        logger.error( "Unable to start a private bus: ", bus.get_last_error( ), "\n" );
+        return;
+    }
+
+    try {
+
+        mock_systemd_t mock( bus.get_address( ) );
+        service_manager_t svc_manager( bus.get_address( ), false );
+
+        logger.info( "Private bus: ", bus.get_address( ).c_str( ), "\n" );
+
+        _bench_status( logger, svc_manager, bus.get_address( ), "mock.service", count );
+        _bench_pipeline( logger, svc_manager, "mock.service", count );
+
+        logger.info( "Mock calls: ", mock.calls( ), "\n" );
+
+        if ( !serve ) return;
+
+        // Other invocations connect with SVCM_BUS_ADDRESS set to the address above
+        logger.info( "Serving until interrupted\n" );
+        logger.flush( );
+
+        while ( true ) {
+            pause( );
+        }
+
+    } catch ( const sdbus::Error& e ) {
+
+        logger.error( "D-Bus error: ", e.what( ), "\n" );
+
+    }
+}
 
 int main( int argc, char** argv ) {
 
@@ -38,6 +364,46 @@ int main( int argc, char** argv ) {
         return EXIT_FAILURE;
     }
    
+    if ( argc < 2 ) {
+        logger.error("Invalid arguments. Service Name and Task requried.\n" );
+        logger.close();
+        return EXIT_FAILURE;
+    }
+    std::string svc_task = std::string( argv[1] );
+
+    // Benches that need no network or host systemd
+    if ( svc_task == "jitter" ) {
+
+        int count = argc > 2 ? std::atoi( argv[2] ) : 100;
+        _bench_jitter( logger, count > 0 ? count : 100 );
+        logger.close( );
+
+        return EXIT_SUCCESS;
+
+    } else if ( svc_task == "fake" ) {
+
+        // fake [units] [workers] [latency us] [job ms] [failure rate]
+        int count = argc > 2 ? std::atoi( argv[2] ) : 1000;
+        int workers = argc > 3 ? std::atoi( argv[3] ) : 4;
+        long latency_us = argc > 4 ? std::atol( argv[4] ) : 200;
+        long job_ms = argc > 5 ? std::atol( argv[5] ) : 5;
+        double failure_rate = argc > 6 ? std::atof( argv[6] ) : 0.0;
+
+        _bench_fake( logger, count > 0 ? count : 1000, workers > 0 ? workers : 4, latency_us, job_ms, failure_rate );
+        logger.close( );
+
+        return EXIT_SUCCESS;
+
+    } else if ( svc_task == "mock" || svc_task == "mock-serve" ) {
+
+        int count = argc > 2 ? std::atoi( argv[2] ) : 1000;
+        _bench_mock( logger, count > 0 ? count : 1000, svc_task == "mock-serve" );
+        logger.close( );
+
+        return EXIT_SUCCESS;
+
+    }
+
     logger.info("Test http request\n");
     logger.flush();
 
@@ -55,15 +421,11 @@ int main( int argc, char** argv ) {
 
     logger.info( body.c_str(), "\n" );
 
-    if ( argc < 2 ) {
-        logger.error("Invalid arguments. Service Name and Task requried.\n" );
-        logger.close();
-        return EXIT_FAILURE;
-    }
     int result = 0;
-    service_manager_t svc_manager;
+    // Points every verb below at another bus, e.g. the one of "mock-serve"
+    const char* bus_address = std::getenv( "SVCM_BUS_ADDRESS" );
+    service_manager_t svc_manager( bus_address != nullptr ? bus_address : "", false );
 
-    std::string svc_task = std::string( argv[1] );
     std::string svc_name = std::string( argv[2] );
 
     _normalized_service_name( svc_name );
@@ -82,12 +444,33 @@ int main( int argc, char** argv ) {
 
     } else if ( svc_task == "status" ) {
 
-        std::string status;
+        unit_status status;
         result = svc_manager.get_status( svc_name, status );
         if ( result > 0 ) {
-            logger.info( svc_name.c_str( ), " status ", status.c_str( ), "\n" );
+            logger.info(
+                svc_name.c_str( ), " status ", _unit_active_state_name( status.active_state ),
+                " (", _unit_sub_state_name( status.sub_state ), ") pid ", status.main_pid,
+                " restarts ", status.restarts, " exit ", status.exec_main_status,
+                " active since ", status.active_enter_timestamp, "\n"
+            );
         }
 
+    } else if ( svc_task == "bench" ) {
+
+        int count = argc > 3 ? std::atoi( argv[3] ) : 1000;
+        _bench_status( logger, svc_manager, bus_address != nullptr ? bus_address : "", svc_name, count > 0 ? count : 1000 );
+        logger.close( );
+
+        return EXIT_SUCCESS;
+
+    } else if ( svc_task == "pipeline" ) {
+
+        int count = argc > 3 ? std::atoi( argv[3] ) : 50;
+        _bench_pipeline( logger, svc_manager, svc_name, count > 0 ? count : 50 );
+        logger.close( );
+
+        return EXIT_SUCCESS;
+
     }
     if ( result < 0 ) {
 
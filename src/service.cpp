@@ -26,54 +26,23 @@
 
 #ifdef USE_PRODUCTION_BUILD
 
-#include <signal.h>
-#include <csignal>
+#include <cstdio>
+#include <cstdlib>
 #include <memory>
-#include <atomic>
 #include <stdexcept>
 #include <exception>
 #include <svc/handler.h>
 
 
-static volatile std::sig_atomic_t _exit_signalled = 0;
 static std::shared_ptr<service_handler_t> _handler;
 
-static void on_signal_caught( int signaled ) {
-    
-    if (_exit_signalled) return;
-
-    _exit_signalled = 1;
-
-    if (!_handler) {
-        fprintf(stderr, "Handler is null. Exiting.\n" );
-        std::_Exit(EXIT_FAILURE);
-        return;
-    }
-
-    _handler->_logger->info("Exit signal received; System Id: ", signaled);
-    _handler->_logger->flush( );
-    _handler->exit( );
-
-}
-
-
-static void _attach_signal( ) {
-    // Interrupt application with ctrl+c or other(s)
-    std::signal( SIGINT, on_signal_caught );
-    // Software termination signal from kill
-    std::signal( SIGTERM, on_signal_caught );
-    // Abnormal termination triggered by abort call
-    std::signal( SIGABRT, on_signal_caught );
-
-#ifdef _WIN32
-    // Ctrl-Break sequence
-    std::signal( SIGBREAK, on_signal_caught );
-#endif //!_WIN32
-}
-
 int main( int argc, char **argv ) {
 
-    _attach_signal( );
+    // Interrupt application with ctrl+c or other(s); the handler's event loop receives them
+    if ( _block_handler_signals( ) < 0 ) {
+        fprintf( stderr, "Unable to block exit signals\n" );
+        return EXIT_FAILURE;
+    }
 
     fprintf( stdout, "Initializing \"Service Manager\"\n" );
 
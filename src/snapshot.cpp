@@ -0,0 +1,239 @@
+/*
+* Copyright FSys Tech Limited [FSys]. All rights reserved.
+*
+* This software owned by FSys Tech Limited [FSys] and is protected by copyright law
+* and international copyright treaties.
+*
+* Access to and use of the software is governed by the terms of the applicable FSys Software
+* Services Agreement (the Agreement) and Customer end user license agreements granting
+* a non-assignable, non-transferable and non-exclusive license to use the software
+* for it's own data processing purposes under the terms defined in the Agreement.
+*
+* Except as otherwise granted within the terms of the Agreement, copying or reproduction of any part
+* of this source code or associated reference material to any other location for further reproduction
+* or redistribution, and any amendments to this copyright notice, are expressly prohibited.
+*
+* Any reproduction or redistribution for sale or hiring of the Software not in accordance with
+* the terms of the Agreement is a violation of copyright law.
+*/
+// 10:30 AM 10/18/2026
+// by Rajib Chy
+
+#include <svc/snapshot.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+// Slots of a new file; grown when more services are configured
+constexpr uint32_t INITIAL_CAPACITY = 64;
+
+constexpr char SNAPSHOT_MAGIC[4] = { 'S', 'V', 'C', 'S' };
+
+service_snapshot_t::~service_snapshot_t( ) {
+    close( );
+}
+
+void service_snapshot_t::set_last_error( const char* action ) {
+    _last_error = std::string( action ) + ": " + std::strerror( errno );
+}
+
+const char* service_snapshot_t::get_last_error( ) {
+    return _last_error.c_str( );
+}
+
+service_snapshot_t::record* service_snapshot_t::records( ) const {
+    return reinterpret_cast<record*>( reinterpret_cast<char*>( _header ) + sizeof( header ) );
+}
+
+uint32_t service_snapshot_t::checksum( ) const {
+
+    const unsigned char* begin = reinterpret_cast<const unsigned char*>( &_header->capacity );
+    const unsigned char* end = reinterpret_cast<const unsigned char*>( records( ) + std::min( _header->count, _header->capacity ) );
+
+    uint32_t hash = 2166136261u;
+
+    for ( const unsigned char* p = begin; p < end; p++ ) {
+        hash = ( hash ^ *p ) * 16777619u;
+    }
+
+    return hash;
+}
+
+int service_snapshot_t::open( const std::string& path ) {
+
+    _fd = ::open( path.c_str( ), O_RDWR | O_CREAT | O_CLOEXEC, 0600 );
+
+    if ( _fd < 0 ) {
+        set_last_error( "open" );
+        return -1;
+    }
+
+    struct stat info;
+
+    if ( fstat( _fd, &info ) < 0 ) {
+        set_last_error( "fstat" );
+        close( );
+        return -1;
+    }
+
+    uint32_t capacity = INITIAL_CAPACITY;
+
+    // Keep the slots of an existing file, a foreign or truncated one is reset below
+    if ( static_cast<size_t>( info.st_size ) > sizeof( header ) ) {
+        size_t slots = ( static_cast<size_t>( info.st_size ) - sizeof( header ) ) / sizeof( record );
+        if ( slots > capacity ) capacity = static_cast<uint32_t>( slots );
+    }
+
+    if ( map( capacity ) < 0 ) {
+        close( );
+        return -1;
+    }
+
+    if ( std::memcmp( _header->magic, SNAPSHOT_MAGIC, sizeof( SNAPSHOT_MAGIC ) ) != 0 ||
+        _header->version != VERSION || _header->capacity != capacity ) {
+
+        std::memset( _header, 0, _length );
+        std::memcpy( _header->magic, SNAPSHOT_MAGIC, sizeof( SNAPSHOT_MAGIC ) );
+        _header->version = VERSION;
+        _header->capacity = capacity;
+        _header->checksum = checksum( );
+    }
+
+    return 1;
+}
+
+int service_snapshot_t::map( uint32_t capacity ) {
+
+    size_t length = sizeof( header ) + static_cast<size_t>( capacity ) * sizeof( record );
+
+    if ( ftruncate( _fd, static_cast<off_t>( length ) ) < 0 ) {
+        set_last_error( "ftruncate" );
+        return -1;
+    }
+
+    void* address = mmap( nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, _fd, 0 );
+
+    if ( address == MAP_FAILED ) {
+        set_last_error( "mmap" );
+        return -1;
+    }
+
+    _header = static_cast<header*>( address );
+    _length = length;
+
+    return 1;
+}
+
+void service_snapshot_t::unmap( ) {
+
+    if ( _header != nullptr ) {
+        munmap( _header, _length );
+        _header = nullptr;
+        _length = 0;
+    }
+}
+
+void service_snapshot_t::close( ) {
+
+    unmap( );
+
+    if ( _fd >= 0 ) {
+        ::close( _fd );
+        _fd = -1;
+    }
+}
+
+bool service_snapshot_t::is_open( ) const {
+    return _header != nullptr;
+}
+
+int service_snapshot_t::restore( const std::string& date, const service_registry_t& registry, service_table_t& services ) {
+
+    if ( _header == nullptr || _header->count > _header->capacity ) return 0;
+
+    if ( _header->checksum != checksum( ) ) return 0;
+
+    if ( std::strncmp( _header->date, date.c_str( ), sizeof( _header->date ) ) != 0 ) return 0;
+
+    int restored = 0;
+    const record* entries = records( );
+
+    for ( uint32_t i = 0; i < _header->count; i++ ) {
+
+        const record& entry = entries[i];
+
+        // A checksummed record is still checked, the name must be terminated
+        if ( std::memchr( entry.name, '\0', sizeof( entry.name ) ) == nullptr ) continue;
+
+        size_t index = registry.find( entry.name );
+
+        if ( index == service_registry_t::npos || entry.state > static_cast<uint8_t>( service_state::FAILED_BACKOFF ) ) continue;
+
+        svc_schedule& schedule = services.get_schedule( index );
+
+        schedule.state = static_cast<service_state>( entry.state );
+        schedule.is_restarted = entry.is_restarted != 0;
+        schedule.start_failures = entry.start_failures;
+        schedule.last_start_epoch = static_cast<std::time_t>( entry.last_start_epoch );
+        schedule.retry_epoch = static_cast<std::time_t>( entry.retry_epoch );
+
+        restored++;
+    }
+
+    return restored;
+}
+
+int service_snapshot_t::save( const std::string& date, const service_table_t& services ) {
+
+    if ( _header == nullptr ) return -1;
+
+    if ( services.size( ) > _header->capacity ) {
+
+        uint32_t capacity = _header->capacity;
+
+        while ( capacity < services.size( ) ) capacity *= 2;
+
+        unmap( );
+
+        if ( map( capacity ) < 0 ) return -1;
+
+        _header->capacity = capacity;
+    }
+
+    record* entries = records( );
+    uint32_t count = 0;
+
+    for ( size_t i = 0; i < services.size( ); i++ ) {
+
+        const std::string& name = services.get_config( i ).service_name;
+
+        if ( name.size( ) > MAX_NAME_LENGTH ) continue;
+
+        const svc_schedule& schedule = services.get_schedule( i );
+        record& entry = entries[count++];
+
+        std::memset( &entry, 0, sizeof( entry ) );
+        std::memcpy( entry.name, name.c_str( ), name.size( ) );
+        entry.state = static_cast<uint8_t>( schedule.state );
+        entry.is_restarted = schedule.is_restarted ? 1 : 0;
+        entry.start_failures = schedule.start_failures;
+        entry.last_start_epoch = static_cast<int64_t>( schedule.last_start_epoch );
+        entry.retry_epoch = static_cast<int64_t>( schedule.retry_epoch );
+    }
+
+    _header->count = count;
+    std::memset( _header->date, 0, sizeof( _header->date ) );
+    std::strncpy( _header->date, date.c_str( ), sizeof( _header->date ) - 1 );
+
+    // Published last; a crash before this leaves a snapshot that fails validation
+    _header->checksum = checksum( );
+
+    // Handed to the disk in the background, a process crash keeps the page cache anyway
+    msync( _header, _length, MS_ASYNC );
+
+    return 1;
+}
@@ -22,6 +22,7 @@
 #include <svc/time-range.h>
 #include <regex>
 #include <cstring> // Include for memset
+#include <stdexcept>
 
 /**
  * @brief Retrieves the current system date in "YYYY-MM-DD" format.
@@ -49,6 +50,25 @@ void _get_current_date( std::string& result ) {
     oss.str( ).swap( result );
 }
 
+std::time_t _get_next_midnight( const std::time_t& now_time ) {
+    std::tm tm_struct;
+
+#ifdef _WIN32
+    localtime_s( &tm_struct, &now_time ); // Windows-safe localtime
+#else
+    localtime_r( &now_time, &tm_struct ); // POSIX-safe localtime
+#endif //!_WIN32
+
+    // mktime normalizes the day overflow and resolves DST
+    tm_struct.tm_mday += 1;
+    tm_struct.tm_hour = 0;
+    tm_struct.tm_min = 0;
+    tm_struct.tm_sec = 0;
+    tm_struct.tm_isdst = -1;
+
+    return std::mktime( &tm_struct );
+}
+
 // Regular expression to match YYYY-mm-dd format
 const std::regex date_pattern(R"(^(\d{4})-(\d{2})-(\d{2})$)");
 
@@ -90,18 +110,23 @@ bool _is_valid_date( const std::string& date_str ) {
     return (day >= 1 && day <= max_days);
 }
 
+constexpr char EMPTY_TIME[] = "00:00:00";
+
 /**
- * @brief Converts a time string (HH:MM:SS) into a `std::tm` structure with today's date.
- *
- * This function parses a time string formatted as "HH:MM:SS" and fills a `std::tm` structure.
- * It also assigns the current date (year, month, day) to ensure a valid `std::tm` value.
+ * @brief Parses a time string (HH:MM:SS) into seconds of the day.
  *
  * @param[in] time_str The time string in the format "HH:MM:SS".
- * @param[out] tm The `std::tm` structure that will be populated with the parsed time and today's date.
+ * @return The seconds since midnight, or -1 if `time_str` is empty or `EMPTY_TIME`.
  * 
  * @throws std::runtime_error If the time string cannot be parsed.
  */
-void _string_to_tm( const std::string& time_str, std::tm& tm ) {
+int _parse_time_of_day( const std::string& time_str ) {
+
+    if ( time_str.empty( ) || time_str == EMPTY_TIME ) return -1;
+
+    // guaranteed zero initialization
+    std::tm tm;
+    memset( &tm, 0, sizeof( std::tm ) );
 
     std::istringstream ss( time_str );
     ss >> std::get_time( &tm, "%H:%M:%S" );
@@ -110,56 +135,35 @@ void _string_to_tm( const std::string& time_str, std::tm& tm ) {
         throw std::runtime_error( "Failed to parse time string" );
     }
 
-    // Set a valid date (e.g., today) to avoid mktime() issues
-    std::time_t t = std::time(nullptr);
-    std::tm now;
-#ifdef _WIN32
-    localtime_s(&now, &t);  // Windows thread-safe version
-#else
-    localtime_r(&t, &now);  // POSIX thread-safe version
-#endif //!_WIN32
-
-    // Set current date
-    tm.tm_year = now.tm_year;
-    tm.tm_mon  = now.tm_mon;
-    tm.tm_mday = now.tm_mday;
-
-    return;
-}
-
-/**
- * @brief Converts a `std::tm` structure into a `std::time_t` epoch timestamp.
- *
- * @param[in] tm The `std::tm` structure representing a date and time.
- * @return std::time_t The corresponding epoch time (seconds since Unix epoch).
- */
-std::time_t _tm_to_time_t( std::tm& tm ) {
-    return std::mktime( &tm );
+    return tm.tm_hour * 3600 + tm.tm_min * 60 + tm.tm_sec;
 }
 
 /**
- * @brief Converts a time string (HH:MM:SS) into a time_t epoch value for today's date.
- *
- * This function takes a time string in the format "HH:MM:SS", parses it into a `std::tm` structure,
- * and sets the current date before converting it into an epoch time (`std::time_t`).
+ * @brief Converts seconds of the day into a time_t epoch value for today's date.
  *
- * @param[in] time_str The input time string in the format "HH:MM:SS".
+ * @param[in] seconds The seconds since midnight.
  * @param[out] epoch The output epoch time (seconds since Unix epoch) for today at the given time.
  *
- * @throws std::runtime_error if the input time string is not in a valid "HH:MM:SS" format.
- *
  * @note The function assumes the system's local timezone unless modified explicitly.
  */
-void _convert_to_epoch( const std::string& time_str, std::time_t& epoch ) {
-        // guaranteed zero initialization
-        std::tm start_tm;
-        memset( &start_tm, 0, sizeof( std::tm ) );
+void _convert_to_epoch( int seconds, std::time_t& epoch ) {
+
+    std::time_t t = std::time( nullptr );
+    std::tm tm;
+#ifdef _WIN32
+    localtime_s( &tm, &t );  // Windows thread-safe version
+#else
+    localtime_r( &t, &tm );  // POSIX thread-safe version
+#endif //!_WIN32
 
-        // Convert time strings to struct tm
-        _string_to_tm( time_str, start_tm );
+    // Keep today's date, mktime resolves DST
+    tm.tm_hour = seconds / 3600;
+    tm.tm_min = ( seconds / 60 ) % 60;
+    tm.tm_sec = seconds % 60;
+    tm.tm_isdst = -1;
 
-        // Convert struct tm to time_t for easier time-based comparisons
-        epoch =  _tm_to_time_t( start_tm );
+    // Convert struct tm to time_t for easier time-based comparisons
+    epoch = std::mktime( &tm );
 }
 
 /**
@@ -225,13 +229,11 @@ void time_range_t::print( std::shared_ptr<svc_logger>& logger ) const {
     
 }
 
-constexpr char EMPTY_TIME[] = "00:00:00";
-
 time_range_t::time_range_t( const std::string& start_time, const std::string& end_time, const std::string& restart_time ) {
 
-    _end_time = std::string( end_time );
-    _start_time = std::string( start_time );
-    _restart_time = std::string( restart_time );
+    _end_seconds = _parse_time_of_day( end_time );
+    _start_seconds = _parse_time_of_day( start_time );
+    _restart_seconds = _parse_time_of_day( restart_time );
 
     prepare( );
 }
@@ -240,18 +242,35 @@ bool time_range_t::is_restart_supported( ) const {
     return _restart_epoch > 0;
 }
 
+bool time_range_t::equals( const time_range_t& other ) const {
+    return _start_seconds == other._start_seconds &&
+        _end_seconds == other._end_seconds &&
+        _restart_seconds == other._restart_seconds;
+}
+
+std::time_t time_range_t::get_start_epoch( ) const {
+    return _start_epoch;
+}
+
+std::time_t time_range_t::get_end_epoch( ) const {
+    return _end_epoch;
+}
+
+std::time_t time_range_t::get_restart_epoch( ) const {
+    return _restart_epoch;
+}
+
 void time_range_t::prepare() {
 
-    if ( _restart_time.empty() || _restart_time == EMPTY_TIME ) {
+    if ( _restart_seconds < 0 ) {
         // If time values are invalid, reset epochs to 0
         _restart_epoch = 0;
     } else {
-        _convert_to_epoch( _restart_time, _restart_epoch );
+        _convert_to_epoch( _restart_seconds, _restart_epoch );
     }
 
     // Check if either start time or end time is empty or set to EMPTY_TIME
-    if ( _start_time.empty() || _start_time == EMPTY_TIME || 
-        _end_time.empty() || _end_time == EMPTY_TIME) {
+    if ( _start_seconds < 0 || _end_seconds < 0 ) {
         
         // If time values are invalid, reset epochs to 0
         _start_epoch = 0;
@@ -259,8 +278,8 @@ void time_range_t::prepare() {
 
     } else {
 
-        _convert_to_epoch( _end_time, _end_epoch );
-        _convert_to_epoch( _start_time, _start_epoch );
+        _convert_to_epoch( _end_seconds, _end_epoch );
+        _convert_to_epoch( _start_seconds, _start_epoch );
 
     }
 }
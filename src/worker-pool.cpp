@@ -0,0 +1,275 @@
+/*
+* Copyright FSys Tech Limited [FSys]. All rights reserved.
+*
+* This software owned by FSys Tech Limited [FSys] and is protected by copyright law
+* and international copyright treaties.
+*
+* Access to and use of the software is governed by the terms of the applicable FSys Software
+* Services Agreement (the Agreement) and Customer end user license agreements granting
+* a non-assignable, non-transferable and non-exclusive license to use the software
+* for it's own data processing purposes under the terms defined in the Agreement.
+*
+* Except as otherwise granted within the terms of the Agreement, copying or reproduction of any part
+* of this source code or associated reference material to any other location for further reproduction
+* or redistribution, and any amendments to this copyright notice, are expressly prohibited.
+*
+* Any reproduction or redistribution for sale or hiring of the Software not in accordance with
+* the terms of the Agreement is a violation of copyright law.
+*/
+// 2:40 PM 10/16/2026
+// by Rajib Chy
+
+#include <svc/worker-pool.h>
+#include <chrono>
+#include <algorithm>
+
+// Slice of a job wait after which a worker checks for shutdown
+constexpr long JOB_WAIT_SLICE_MS = 100;
+
+// Upper bound of the actions one worker sends as a pipelined batch
+constexpr size_t MAX_BATCH = 32;
+
+service_worker_pool_t::service_worker_pool_t( size_t workers, long job_wait_ms, const service_backend_factory& backend_factory, std::function<void( )> notify )
+    : _job_wait_ms( job_wait_ms ), _notify( std::move( notify ) ) {
+
+    // Connect first, so a bus failure surfaces before any thread runs
+    for ( size_t i = 0; i < workers; i++ ) {
+        _managers.push_back( backend_factory( false ) );
+    }
+
+    for ( size_t i = 0; i < workers; i++ ) {
+        _threads.emplace_back( &service_worker_pool_t::run, this, i );
+    }
+}
+
+service_worker_pool_t::~service_worker_pool_t( ) {
+    stop( );
+}
+
+void service_worker_pool_t::stop( ) {
+
+    {
+        std::lock_guard<std::mutex> lock( _mutex );
+        _stopping = true;
+    }
+
+    _cv.notify_all( );
+
+    for ( auto& thread : _threads ) {
+        if ( thread.joinable( ) ) {
+            thread.join( );
+        }
+    }
+
+    _threads.clear( );
+    _managers.clear( );
+}
+
+void service_worker_pool_t::submit( size_t service_index, const std::string& service_name, service_action action ) {
+
+    {
+        std::lock_guard<std::mutex> lock( _mutex );
+
+        if ( _stopping ) return;
+
+        std::deque<action_request>& queue = _queues[service_index];
+        queue.push_back( action_request{ service_index, service_name, action } );
+
+        // Otherwise an action of this service is queued or running; it is picked up after that one
+        if ( queue.size( ) != 1 ) return;
+
+        _ready.push_back( service_index );
+    }
+
+    _cv.notify_one( );
+}
+
+void service_worker_pool_t::hold( ) {
+    std::lock_guard<std::mutex> lock( _mutex );
+    _held = true;
+}
+
+void service_worker_pool_t::release( ) {
+
+    {
+        std::lock_guard<std::mutex> lock( _mutex );
+        if ( !_held ) return;
+        _held = false;
+    }
+
+    _cv.notify_all( );
+}
+
+size_t service_worker_pool_t::drain( std::vector<action_result>& results ) {
+
+    results.clear( );
+
+    std::lock_guard<std::mutex> lock( _mutex );
+    results.swap( _results );
+
+    return results.size( );
+}
+
+void service_worker_pool_t::run( size_t worker ) {
+
+    service_backend_t& manager = *_managers[worker];
+
+    std::vector<action_request> batch;
+
+    while ( true ) {
+
+        batch.clear( );
+
+        {
+            std::unique_lock<std::mutex> lock( _mutex );
+
+            _cv.wait( lock, [this]( ) {
+                return _stopping || ( !_held && !_ready.empty( ) );
+            });
+
+            if ( _stopping ) return;
+
+            // An even share of what is ready, the other workers take the rest
+            size_t count = std::min( MAX_BATCH, ( _ready.size( ) + _managers.size( ) - 1 ) / _managers.size( ) );
+
+            // The actions stay at the front of their queues until they finished
+            for ( size_t i = 0; i < count; i++ ) {
+                batch.push_back( _queues[_ready.front( )].front( ) );
+                _ready.pop_front( );
+            }
+        }
+
+        perform( manager, batch );
+    }
+}
+
+void service_worker_pool_t::perform( service_backend_t& manager, const std::vector<action_request>& batch ) {
+
+    std::vector<unit_request> requests( batch.size( ) );
+
+    for ( size_t i = 0; i < batch.size( ); i++ ) {
+
+        unit_request& request = requests[i];
+        request.service_name = batch[i].service_name;
+
+        switch ( batch[i].action ) {
+            case service_action::START: request.operation = unit_operation::START; break;
+            case service_action::STOP: request.operation = unit_operation::STOP; break;
+            case service_action::RESTART: request.operation = unit_operation::RESTART; break;
+            case service_action::RETRY:
+                // Clears systemd's start rate limit as well; pipelined with the rest of the batch
+                request.reset_failed = true;
+                request.operation = unit_operation::START;
+                break;
+        }
+    }
+
+    manager.call_many( requests );
+
+    // Completions are collected here, the callbacks may outlive this call
+    struct completion {
+        std::mutex mutex;
+        std::condition_variable cv;
+        std::vector<size_t> done;
+    };
+
+    auto completed = std::make_shared<completion>( );
+    std::vector<action_result> results( batch.size( ) );
+    size_t waiting = 0;
+
+    for ( size_t i = 0; i < batch.size( ); i++ ) {
+
+        action_result& result = results[i];
+        result.service_index = batch[i].service_index;
+        result.action = batch[i].action;
+        result.status = requests[i].status;
+
+        if ( result.status != 1 || !requests[i].job ) {
+            result.status = -1;
+            result.result = job_result::FAILED;
+            result.error = requests[i].error;
+            post( batch[i], result );
+            continue;
+        }
+
+        result.job_path = requests[i].job->get_path( );
+        waiting++;
+
+        requests[i].job->on_complete( [completed, i]( job_result ) {
+            std::lock_guard<std::mutex> lock( completed->mutex );
+            completed->done.push_back( i );
+            completed->cv.notify_one( );
+        });
+    }
+
+    auto deadline = std::chrono::steady_clock::now( ) + std::chrono::milliseconds( _job_wait_ms );
+    std::vector<size_t> done;
+
+    while ( waiting > 0 ) {
+
+        {
+            std::unique_lock<std::mutex> lock( completed->mutex );
+            completed->cv.wait_for( lock, std::chrono::milliseconds( JOB_WAIT_SLICE_MS ), [&completed]( ) {
+                return !completed->done.empty( );
+            });
+            done.swap( completed->done );
+        }
+
+        for ( size_t i : done ) {
+            results[i].result = requests[i].job->get_result( );
+            post( batch[i], results[i] );
+            waiting--;
+        }
+
+        done.clear( );
+
+        if ( waiting == 0 || ( !_stopping && std::chrono::steady_clock::now( ) < deadline ) ) continue;
+
+        if ( _stopping ) break;
+
+        // Outlived the wait; the service stays busy until its job finished, so its
+        // next action is not sent while systemd still runs this one
+        for ( size_t i = 0; i < batch.size( ); i++ ) {
+
+            if ( results[i].status != 1 || results[i].result != job_result::PENDING ) continue;
+
+            requests[i].job->on_complete( [this, request = batch[i], result = std::move( results[i] )]( job_result job ) mutable {
+                result.result = job;
+                post( request, result );
+            });
+        }
+
+        break;
+    }
+}
+
+void service_worker_pool_t::post( const action_request& request, action_result& result ) {
+
+    {
+        std::lock_guard<std::mutex> lock( _mutex );
+
+        _results.push_back( std::move( result ) );
+
+        auto it = _queues.find( request.service_index );
+        it->second.pop_front( );
+
+        if ( it->second.empty( ) ) {
+            _queues.erase( it );
+        } else {
+            _ready.push_back( request.service_index );
+            _cv.notify_one( );
+        }
+    }
+
+    _notify( );
+}
+
+const char* _service_action_name( service_action action ) {
+    switch ( action ) {
+        case service_action::START: return "start";
+        case service_action::STOP: return "stop";
+        case service_action::RETRY: return "retry";
+        case service_action::RESTART:
+        default: return "restart";
+    }
+}